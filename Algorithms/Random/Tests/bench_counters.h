@@ -0,0 +1,46 @@
+#pragma once
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <string>
+#include "Utility/benchmark.h"
+#include "Algorithms/Random/propabilistic_counter.h"
+
+/// <summary>
+/// Compares PropabilisticCounter with ApproximateCounterBank: single thread increments, batched Add, and increments from thread_count threads
+/// counters has to be power of 2, results are printed in millions of counted events per second
+/// </summary>
+inline void bench_counters(const size_t& counters = 1 << 20, const size_t& events = 1 << 24, unsigned int thread_count = 0)
+{
+	if (thread_count == 0)
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+	PropabilisticCounter morris;
+	print_throughput("PropabilisticCounter::Increment", measure_throughput([&]() {
+		for (size_t x = 0; x < events; x++)
+			morris.Increment();
+	}, events), "events/s");
+
+	ApproximateCounterBank<> bank(counters);
+	print_throughput("ApproximateCounterBank::Increment", measure_throughput([&]() {
+		for (size_t x = 0; x < events; x++)
+			bank.Increment(x & (counters - 1));
+	}, events), "events/s");
+
+	const uint64_t batch = 1000;
+	print_throughput("ApproximateCounterBank::Add(1000)", measure_throughput([&]() {
+		for (size_t x = 0; x < events / batch; x++)
+			bank.Add(x & (counters - 1), batch);
+	}, events), "events/s");
+
+	print_throughput("ApproximateCounterBank::Increment threads=" + std::to_string(thread_count), measure_throughput([&]() {
+		std::vector<std::thread> threads;
+		for (unsigned int t = 0; t < thread_count; t++)
+			threads.emplace_back([&, t]() {
+				for (size_t x = t; x < events; x += thread_count)
+					bank.Increment((x * 0x9E3779B97F4A7C15ull >> 20) & (counters - 1));
+			});
+		for (auto& thread : threads)
+			thread.join();
+	}, events), "events/s");
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <memory>
+#include "Utility/benchmark.h"
+#include "Algorithms/Random/random.h"
+
+/// <summary>
+/// Measures how many raw 64 bit numbers per second given engine generates
+/// </summary>
+template<class Engine>
+double bench_engine(Engine& engine, const size_t& count)
+{
+	volatile uint64_t sink = 0;
+	return measure_throughput([&]() {
+		uint64_t sum = 0;
+		for (size_t x = 0; x < count; x++)
+			sum += engine();
+		sink = sum;
+	}, count);
+}
+
+/// <summary>
+/// Compares throughput of random engines, and of bounded numbers generated by StaticRandom and std::uniform_int_distribution
+/// Results are printed in millions of numbers per second
+/// </summary>
+inline void bench_random_engines(const size_t& count = 50000000)
+{
+	std::random_device rd;
+	std::mt19937 mt(1);
+	std::mt19937_64 mt64(1);
+	SplitMix64 splitmix(1);
+	Xoshiro256StarStar xoshiro(1);
+	PCG64 pcg(1);
+
+	std::cout << "Raw engines:\n";
+	print_throughput("std::random_device", bench_engine(rd, count / 1000), "numbers/s");
+	print_throughput("std::mt19937", bench_engine(mt, count), "numbers/s");
+	print_throughput("std::mt19937_64", bench_engine(mt64, count), "numbers/s");
+	print_throughput("SplitMix64", bench_engine(splitmix, count), "numbers/s");
+	print_throughput("Xoshiro256StarStar", bench_engine(xoshiro, count), "numbers/s");
+	print_throughput("PCG64", bench_engine(pcg, count), "numbers/s");
+
+	std::cout << "Bounded integers in [0, 1000):\n";
+	volatile long long sink = 0;
+	print_throughput("uniform_int_distribution(random_device)", measure_throughput([&]() {
+		long long sum = 0;
+		for (size_t x = 0; x < count / 1000; x++)
+			sum += std::uniform_int_distribution<int>(0, 999)(rd);
+		sink = sum;
+	}, count / 1000), "numbers/s");
+	print_throughput("uniform_int_distribution(mt19937_64)", measure_throughput([&]() {
+		long long sum = 0;
+		std::uniform_int_distribution<int> dist(0, 999);
+		for (size_t x = 0; x < count; x++)
+			sum += dist(mt64);
+		sink = sum;
+	}, count), "numbers/s");
+	print_throughput("random_bounded(Xoshiro256StarStar)", measure_throughput([&]() {
+		long long sum = 0;
+		for (size_t x = 0; x < count; x++)
+			sum += random_bounded(xoshiro, 1000);
+		sink = sum;
+	}, count), "numbers/s");
+	print_throughput("StaticRandom::Next", measure_throughput([&]() {
+		long long sum = 0;
+		for (size_t x = 0; x < count; x++)
+			sum += StaticRandom::Next(0, 1000);
+		sink = sum;
+	}, count), "numbers/s");
+	print_throughput("BasicStaticRandom<PCG64>::Next", measure_throughput([&]() {
+		long long sum = 0;
+		for (size_t x = 0; x < count; x++)
+			sum += BasicStaticRandom<PCG64>::Next(0, 1000);
+		sink = sum;
+	}, count), "numbers/s");
+}
+
+/// <summary>
+/// Compares generating numbers one by one through StaticRandom with its bulk Fill functions
+/// Results are printed in millions of numbers per second
+/// </summary>
+inline void bench_random_bulk(const size_t& count = 50000000)
+{
+	std::vector<int> ints(count);
+	std::vector<double> doubles(count);
+	std::unique_ptr<bool[]> rolls(new bool[count]);
+
+	print_throughput("StaticRandom::Next loop", measure_throughput([&]() {
+		for (size_t x = 0; x < count; x++)
+			ints[x] = StaticRandom::Next(0, 1000);
+	}, count), "numbers/s");
+	print_throughput("StaticRandom::FillInts", measure_throughput([&]() { StaticRandom::FillInts(ints.data(), count, 0, 1000); }, count), "numbers/s");
+
+	print_throughput("StaticRandom::NextDouble loop", measure_throughput([&]() {
+		for (size_t x = 0; x < count; x++)
+			doubles[x] = StaticRandom::NextDouble(0, 1);
+	}, count), "numbers/s");
+	print_throughput("StaticRandom::FillDoubles", measure_throughput([&]() { StaticRandom::FillDoubles(doubles.data(), count); }, count), "numbers/s");
+
+	print_throughput("StaticRandom::Roll loop", measure_throughput([&]() {
+		for (size_t x = 0; x < count; x++)
+			rolls[x] = StaticRandom::Roll(0.3);
+	}, count), "numbers/s");
+	print_throughput("StaticRandom::FillRolls", measure_throughput([&]() { StaticRandom::FillRolls(rolls.get(), count, 0.3); }, count), "numbers/s");
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <numeric>
+#include "Utility/benchmark.h"
+#include "Algorithms/Random/array_permutations.h"
+#include "Algorithms/Random/reservoir_sampling.h"
+
+/// <summary>
+/// Compares sampling k items from size items: copy and shuffle of whole array, floyd_sample,
+/// ReservoirSampler fed item by item and by AddRange, WeightedReservoirSampler. Results are printed in millions of source items per second
+/// </summary>
+inline void bench_sampling(const size_t& size = size_t(1) << 26, const size_t& k = 1000)
+{
+	std::vector<int> arr(size);
+	std::iota(arr.begin(), arr.end(), 0);
+	std::vector<double> weights(size, 1.0);
+	volatile int sink = 0;
+
+	std::cout << "Sample of " << k << " from " << size << " ints:\n";
+	print_throughput("copy + fast_shuffle", measure_throughput([&]() {
+		std::vector<int> copy(arr);
+		fast_shuffle(copy.data(), size);
+		sink = copy[0];
+	}, size, 3));
+	print_throughput("random_sample (floyd)", measure_throughput([&]() {
+		int* out = random_sample(arr.data(), size, k);
+		sink = out[0];
+		delete[] out;
+	}, size, 3));
+	print_throughput("ReservoirSampler::Add", measure_throughput([&]() {
+		ReservoirSampler<int> sampler(k);
+		for (size_t x = 0; x < size; x++)
+			sampler.Add(arr[x]);
+		sink = sampler.GetSample()[0];
+	}, size, 3));
+	print_throughput("ReservoirSampler::AddRange", measure_throughput([&]() {
+		ReservoirSampler<int> sampler(k);
+		sampler.AddRange(arr.data(), size);
+		sink = sampler.GetSample()[0];
+	}, size, 3));
+	print_throughput("WeightedReservoirSampler", measure_throughput([&]() {
+		WeightedReservoirSampler<int> sampler(k);
+		sampler.AddRange(arr.data(), weights.data(), size);
+		sink = sampler.GetSample()[0];
+	}, size, 3));
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <random>
+#include "Utility/benchmark.h"
+#include "Algorithms/Random/array_permutations.h"
+
+/// <summary>
+/// Compares shuffles of array of size ints: randomly_permute, std::shuffle, fast_shuffle, scatter_shuffle and parallel_shuffle
+/// Results are printed in millions of items per second
+/// </summary>
+inline void bench_shuffle(const size_t& size = size_t(1) << 26, const unsigned int& thread_count = 0)
+{
+	std::vector<int> arr(size);
+	std::iota(arr.begin(), arr.end(), 0);
+	std::mt19937_64 mt(1);
+	Xoshiro256StarStar xoshiro(1);
+
+	std::cout << "Shuffle of " << size << " ints:\n";
+	if (size <= (size_t)INT32_MAX) //randomly_permute uses int indexes
+		print_throughput("randomly_permute", measure_throughput([&]() { randomly_permute(arr.data(), size); }, size, 3));
+	print_throughput("std::shuffle(mt19937_64)", measure_throughput([&]() { std::shuffle(arr.begin(), arr.end(), mt); }, size, 3));
+	print_throughput("std::shuffle(Xoshiro256StarStar)", measure_throughput([&]() { std::shuffle(arr.begin(), arr.end(), xoshiro); }, size, 3));
+	print_throughput("fast_shuffle", measure_throughput([&]() { fast_shuffle(arr.data(), size); }, size, 3));
+	print_throughput("scatter_shuffle", measure_throughput([&]() { scatter_shuffle(arr.data(), size); }, size, 3));
+	print_throughput("parallel_shuffle", measure_throughput([&]() { parallel_shuffle(arr.data(), size, 1, thread_count); }, size, 3));
+}
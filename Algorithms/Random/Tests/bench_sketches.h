@@ -0,0 +1,110 @@
+#pragma once
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <unordered_set>
+#include <unordered_map>
+#include "Utility/benchmark.h"
+#include "Algorithms/Random/random.h"
+#include "Algorithms/Random/hyperloglog.h"
+#include "Algorithms/Random/frequency_sketches.h"
+
+/// <summary>
+/// Measures updates per second of HyperLogLog, CountMinSketch and CountSketch, and compares them with std::unordered_set/map
+/// Stream has size items drawn from distinct different values
+/// </summary>
+inline void bench_sketches_throughput(const size_t& size = 1 << 24, const int& distinct = 1 << 20)
+{
+	std::vector<int> stream(size);
+	Random random(1);
+	random.FillInts(stream.data(), size, 0, distinct);
+
+	std::cout << "Stream of " << size << " items, " << distinct << " distinct values:\n";
+	print_throughput("std::unordered_set::insert", measure_throughput([&]() {
+		std::unordered_set<int> set;
+		for (auto& item : stream)
+			set.insert(item);
+	}, size, 3), "updates/s");
+	print_throughput("HyperLogLog::Add", measure_throughput([&]() {
+		HyperLogLog<int> hll(14);
+		for (auto& item : stream)
+			hll.Add(item);
+	}, size, 3), "updates/s");
+	print_throughput("HyperLogLog::AddRange", measure_throughput([&]() {
+		HyperLogLog<int> hll(14);
+		hll.AddRange(stream.data(), size);
+	}, size, 3), "updates/s");
+
+	print_throughput("std::unordered_map counting", measure_throughput([&]() {
+		std::unordered_map<int, unsigned int> counts;
+		for (auto& item : stream)
+			counts[item]++;
+	}, size, 3), "updates/s");
+	print_throughput("CountMinSketch::Add", measure_throughput([&]() {
+		CountMinSketch<int> sketch(1 << 16, 4);
+		for (auto& item : stream)
+			sketch.Add(item);
+	}, size, 3), "updates/s");
+	print_throughput("CountMinSketch::AddRange", measure_throughput([&]() {
+		CountMinSketch<int> sketch(1 << 16, 4);
+		sketch.AddRange(stream.data(), size);
+	}, size, 3), "updates/s");
+	print_throughput("CountMinSketch::Add, 64MB table", measure_throughput([&]() {
+		CountMinSketch<int> sketch(1 << 22, 4);
+		for (auto& item : stream)
+			sketch.Add(item);
+	}, size, 3), "updates/s");
+	print_throughput("CountMinSketch::AddRange, 64MB table", measure_throughput([&]() {
+		CountMinSketch<int> sketch(1 << 22, 4);
+		sketch.AddRange(stream.data(), size);
+	}, size, 3), "updates/s");
+	print_throughput("CountSketch::AddRange", measure_throughput([&]() {
+		CountSketch<int> sketch(1 << 16, 5);
+		sketch.AddRange(stream.data(), size);
+	}, size, 3), "updates/s");
+}
+
+/// <summary>
+/// Prints relative error of HyperLogLog for every precision, and average absolute error of CountMinSketch and CountSketch
+/// for different widths, next to used memory. Frequencies follow power law, so there are few heavy and many light items
+/// </summary>
+inline void bench_sketches_accuracy(const size_t& size = 1 << 22)
+{
+	std::vector<int> stream(size);
+	Random random(1);
+	for (auto& item : stream) //power law, value v appears about size/v times
+		item = (int)std::pow(2.0, random.NextDouble(0, 22));
+
+	std::unordered_map<int, long long> truth;
+	for (auto& item : stream)
+		truth[item]++;
+
+	std::cout << "HyperLogLog, " << truth.size() << " distinct items:\n";
+	for (int precision = 4; precision <= 18; precision += 2)
+	{
+		HyperLogLog<int> hll(precision);
+		hll.AddRange(stream.data(), size);
+		double error = std::abs(hll.Estimate() - (double)truth.size()) / truth.size();
+		std::cout << "  precision " << std::setw(2) << precision << std::setw(10) << hll.MemoryUsage() << " B  error " << error * 100 << "%\n";
+	}
+
+	std::cout << "Average absolute error of frequency, " << size << " items:\n";
+	for (size_t width = 1 << 8; width <= (1 << 16); width <<= 2)
+	{
+		CountMinSketch<int> count_min(width, 5);
+		CountSketch<int> count_sketch(width, 5);
+		count_min.AddRange(stream.data(), size);
+		count_sketch.AddRange(stream.data(), size);
+
+		double count_min_error = 0, count_sketch_error = 0;
+		for (auto& pair : truth)
+		{
+			count_min_error += std::abs((double)count_min.Estimate(pair.first) - pair.second);
+			count_sketch_error += std::abs((double)count_sketch.Estimate(pair.first) - pair.second);
+		}
+		std::cout << "  width " << std::setw(6) << width << std::setw(10) << count_min.MemoryUsage() << " B  Count-Min "
+			<< count_min_error / truth.size() << "  Count-Sketch " << count_sketch_error / truth.size() << "\n";
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <functional>
+#include "Utility/testing.h"
+#include "Algorithms/Random/propabilistic_counter.h"
+
+//checks that estimates of counters of bank have mean events and variance (base - 1) * events * (events - 1) / 2 of Morris counter
+template<class Engine>
+void check_counter_estimates(TestReport& report, ApproximateCounterBank<Engine>& bank, const double& events, const bool& check_variance, const std::string& name)
+{
+	const size_t size = bank.GetSize();
+	double sum = 0, squares = 0;
+	for (size_t x = 0; x < size; x++)
+	{
+		sum += bank.Approximation(x);
+		squares += bank.Approximation(x) * bank.Approximation(x);
+	}
+	const double mean = sum / size, variance = (squares - sum * mean) / (size - 1);
+	const double expected_variance = (bank.GetBase() - 1) * events * (events - 1) / 2;
+	const std::string suffix = " base=" + std::to_string(bank.GetBase()) + " events=" + std::to_string((uint64_t)events);
+
+	//mean of size estimates has standard deviation sqrt(variance / size)
+	report.check(std::abs(mean - events) <= 5 * std::sqrt(expected_variance / size), name + " mean " + std::to_string(mean) + suffix);
+	if (check_variance)
+		report.check(std::abs(variance / expected_variance - 1) < 0.1, name + " variance " + std::to_string(variance) + " expected " + std::to_string(expected_variance) + suffix);
+}
+
+/// <summary>
+/// Test of ApproximateCounterBank: estimate of Morris counter is unbiased with variance (base - 1) * n * (n - 1) / 2,
+/// so mean and variance over many counters are compared with that after n events counted by Increment, by one Add,
+/// by several Adds and after Merge of two banks (mean only)
+/// </summary>
+/// <param name="seed">Seed of generated numbers</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_counters(const uint64_t& seed = 20240601)
+{
+	TestReport report("approximate counters");
+	BasicStaticRandom<Xoshiro256StarStar>::Seed(seed);
+	const size_t size = 20000;
+
+	for (const double base : { 1.08, 1.5 })
+	{
+		const uint64_t events = 1000;
+		ApproximateCounterBank<> increments(size, base), single(size, base), batches(size, base), large(size, base);
+		for (size_t x = 0; x < size; x++)
+		{
+			for (uint64_t event = 0; event < events; event++)
+				increments.Increment(x);
+			single.Add(x, events);
+			for (int batch = 0; batch < 10; batch++)
+				batches.Add(x, events / 10);
+			large.Add(x, 1000000);
+		}
+		check_counter_estimates(report, increments, (double)events, true, "Increment");
+		check_counter_estimates(report, single, (double)events, true, "Add");
+		check_counter_estimates(report, batches, (double)events, true, "Add in 10 batches");
+		check_counter_estimates(report, large, 1000000.0, true, "Add");
+
+		//merged estimate is unbiased, variance depends on order of rounding, so only mean is checked
+		single.Merge(large);
+		check_counter_estimates(report, single, 1001000.0, false, "Merge");
+	}
+
+	ApproximateCounterBank<> other_size(size + 1), other_base(size, 1.5), bank(size);
+	report.check(!bank.Merge(other_size) && !bank.Merge(other_base), "Merge of banks with different size or base fails");
+
+	BasicStaticRandom<Xoshiro256StarStar>::SeedRandomly();
+	return report.summary();
+}
@@ -0,0 +1,347 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <thread>
+#include <algorithm>
+#include <memory>
+#include <climits>
+#include <array>
+#include "Utility/testing.h"
+#include "Algorithms/Random/random.h"
+
+//checks that engine generates expected numbers
+template<class Engine>
+void check_engine_output(TestReport& report, Engine& engine, const std::vector<uint64_t>& expected, const std::string& name)
+{
+	bool same = true;
+	for (const uint64_t& number : expected)
+		same &= engine() == number;
+	report.check(same, name + " matches reference output");
+}
+
+//checks that two generators of the same kind generate the same numbers
+template<class Generator, class Next>
+bool same_sequence(Generator& a, Generator& b, Next next, const size_t& count = 1000)
+{
+	bool same = true;
+	for (size_t x = 0; x < count; x++)
+		same &= next(a) == next(b);
+	return same;
+}
+
+/// <summary>
+/// Test of random engines and bounded numbers: SplitMix64, xoshiro256** and PCG64 are compared with outputs of reference
+/// implementations of their authors, random_bounded has to stay in range and be uniform (chi-square, and parity for range
+/// 2/3 * 2^64, where multiplication without rejection gives even numbers with chance 2/3), and seeded Random and StaticRandom
+/// have to generate the same numbers for the same seed, also when Seed is the first use of StaticRandom in a thread
+/// </summary>
+/// <param name="seed">Seed of generated numbers</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_random_engines(const uint64_t& seed = 20240601)
+{
+	TestReport report("random engines");
+
+	SplitMix64 splitmix(1234567);
+	check_engine_output(report, splitmix, { 6457827717110365317ull, 3203168211198807973ull, 9817491932198370423ull, 4593380528125082431ull, 16408922859458223821ull }, "SplitMix64 seed=1234567");
+
+	Xoshiro256StarStar xoshiro;
+	const uint64_t state[4] = { 1, 2, 3, 4 };
+	xoshiro.set_state(state);
+	check_engine_output(report, xoshiro, { 11520ull, 0ull, 1509978240ull, 1215971899390074240ull, 1216172134540287360ull, 607988272756665600ull }, "Xoshiro256StarStar state={1,2,3,4}");
+
+	//seed fills state with SplitMix64
+	Xoshiro256StarStar seeded(1234567);
+	uint64_t seeded_state[4];
+	seeded.get_state(seeded_state);
+	report.check(seeded_state[0] == 6457827717110365317ull && seeded_state[3] == 4593380528125082431ull, "Xoshiro256StarStar seed is expanded by SplitMix64");
+
+	PCG64 pcg(42, 54);
+	check_engine_output(report, pcg, { 0x86B1DA1D72062B68ull, 0x1304AA46C9853D39ull, 0xA3670E9E0DD50358ull, 0xF9090E529A7DAE00ull, 0xC85B9FD837996F2Cull, 0x606121F8E3919196ull }, "PCG64 seed=42 stream=54");
+
+	//random_bounded stays in range, including ranges of 1 and of 2^64 - 1
+	Xoshiro256StarStar engine(seed);
+	bool in_range = true;
+	for (const uint64_t range : std::vector<uint64_t>{ 1, 2, 3, 7, 1000, 0x80000001ull, 0x8000000000000001ull, UINT64_MAX })
+		for (int x = 0; x < 10000; x++)
+			in_range &= random_bounded(engine, range) < range;
+	report.check(in_range, "random_bounded stays in [0, range)");
+
+	const size_t small_range = 7, draws = 700000;
+	std::vector<size_t> counts(small_range, 0);
+	for (size_t x = 0; x < draws; x++)
+		counts[random_bounded(engine, small_range)]++;
+	const double statistic = chi_square(counts);
+	report.check(statistic < chi_square_critical(small_range - 1), "random_bounded over 7 values is uniform, chi-square " + std::to_string(statistic));
+
+	const uint64_t biased_range = 0xAAAAAAAAAAAAAAAAull;
+	size_t even = 0;
+	for (size_t x = 0; x < draws; x++)
+		even += random_bounded(engine, biased_range) % 2 == 0;
+	const double even_rate = (double)even / draws;
+	report.check(even_rate > 0.49 && even_rate < 0.51, "random_bounded rejects biased numbers, even rate " + std::to_string(even_rate) + " (2/3 without rejection)");
+
+	//the same seed generates the same numbers
+	Random first(seed), second(seed);
+	report.check(same_sequence(first, second, [](Random& random) { return random.Next(0, 1000); }), "Random with the same seed");
+	second.Seed(seed + 1);
+	first.Seed(seed + 1);
+	report.check(same_sequence(first, second, [](Random& random) { return random.NextLong(-5, 1ll << 50); }), "Random after Seed");
+	BasicRandom<PCG64> pcg_first(seed), pcg_second(seed);
+	report.check(same_sequence(pcg_first, pcg_second, [](BasicRandom<PCG64>& random) { return random.NextDouble(0, 1); }), "BasicRandom<PCG64> with the same seed");
+	Random other(seed + 2);
+	first.Seed(seed);
+	report.check(!same_sequence(first, other, [](Random& random) { return random.Next(0, 1 << 30); }, 10), "Random with different seeds");
+
+	//engines of StaticRandom are thread local, every run starts in new thread, so Seed is the first use of engines there
+	auto static_run = [seed](const bool& stream) {
+		std::vector<int> numbers;
+		std::thread thread([&]() {
+			for (int run = 0; run < 2; run++)
+			{
+				if (stream)
+					StaticRandom::SeedStream(seed, 3);
+				else
+					StaticRandom::Seed(seed);
+				for (int x = 0; x < 1000; x++)
+					numbers.push_back(StaticRandom::Next(0, 1000));
+			}
+			StaticRandom::SeedRandomly();
+		});
+		thread.join();
+		return numbers;
+	};
+	for (const bool stream : { false, true })
+	{
+		const std::vector<int> numbers = static_run(stream), repeated = static_run(stream);
+		const std::string method = stream ? "StaticRandom::SeedStream" : "StaticRandom::Seed";
+		report.check(numbers == repeated, method + " gives the same numbers in every thread");
+		report.check(std::equal(numbers.begin(), numbers.begin() + 1000, numbers.begin() + 1000), method + " called again repeats the numbers");
+	}
+
+	return report.summary();
+}
+
+/// <summary>
+/// Test of bulk generation: lanes of MultiXoshiro256StarStar have to be jump() streams of xoshiro256** with the same seed,
+/// random_fill_bounded has to stay in bounds and be uniform (also for range 3/4 * 2^32, where most blocks need rejection),
+/// random_fill_double has to stay in [0, 1), random_fill_bernoulli has to succeed with given chance, and Fill functions
+/// of Random have to repeat their numbers for the same seed. Counts are not multiples of lanes or blocks, so tails are covered
+/// </summary>
+/// <param name="seed">Seed of generated numbers</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_random_bulk(const uint64_t& seed = 20240601)
+{
+	TestReport report("random bulk");
+	const size_t count = 100003;
+
+	//lane l is l-th jump() stream, numbers of lanes are interleaved, the tail takes the first lanes
+	MultiXoshiro256StarStar<8> bulk(seed);
+	std::vector<uint64_t> numbers(8 * 100 + 5);
+	bulk.fill(numbers.data(), numbers.size());
+	bool lanes_match = true;
+	for (int lane = 0; lane < 8; lane++)
+	{
+		Xoshiro256StarStar engine = Xoshiro256StarStar::stream(seed, lane);
+		for (size_t x = lane; x < numbers.size(); x += 8)
+			lanes_match &= numbers[x] == engine();
+	}
+	report.check(lanes_match, "MultiXoshiro256StarStar lanes are jump streams of Xoshiro256StarStar");
+
+	Xoshiro256StarStar single(seed);
+	std::vector<int> ints(count);
+	for (const std::pair<int, int>& range : std::vector<std::pair<int, int>>{ { 0, 1 }, { -5, 5 }, { 0, 1000 }, { INT_MIN, INT_MAX }, { -1000000, 1000000000 } })
+	{
+		random_fill_bounded(bulk, single, ints.data(), count, range.first, range.second);
+		const bool in_bounds = std::all_of(ints.begin(), ints.end(), [&](const int& item) { return item >= range.first && item < range.second; });
+		report.check(in_bounds, "random_fill_bounded in [" + std::to_string(range.first) + ", " + std::to_string(range.second) + ")");
+	}
+
+	std::vector<size_t> counts(10, 0);
+	random_fill_bounded(bulk, single, ints.data(), count, 0, 10);
+	for (const int& item : ints)
+		counts[item]++;
+	report.check(chi_square(counts) < chi_square_critical(9), "random_fill_bounded over 10 values is uniform, chi-square " + std::to_string(chi_square(counts)));
+
+	//range 3/4 * 2^32: without rejection every third value would be twice as likely
+	const int left = INT_MIN, right = (int)((long long)INT_MIN + 0xC0000000ll);
+	std::vector<size_t> residues(3, 0);
+	for (int run = 0; run < 10; run++)
+	{
+		random_fill_bounded(bulk, single, ints.data(), count, left, right);
+		for (const int& item : ints)
+			residues[(size_t)((long long)item - left) % 3]++;
+	}
+	report.check(chi_square(residues) < chi_square_critical(2), "random_fill_bounded rejects biased numbers, chi-square of residues " + std::to_string(chi_square(residues)));
+
+	std::vector<double> doubles(count);
+	random_fill_double(bulk, doubles.data(), count);
+	double sum = 0;
+	for (const double& item : doubles)
+		sum += item;
+	report.check(std::all_of(doubles.begin(), doubles.end(), [](const double& item) { return item >= 0 && item < 1; }), "random_fill_double in [0, 1)");
+	report.check(std::abs(sum / count - 0.5) < 0.01, "random_fill_double mean " + std::to_string(sum / count));
+
+	std::unique_ptr<bool[]> rolls(new bool[count]);
+	for (const double chance : { 0.0, 0.001, 0.3, 0.5, 0.999, 1.0 })
+	{
+		random_fill_bernoulli(bulk, rolls.get(), count, chance);
+		const double rate = (double)std::count(rolls.get(), rolls.get() + count, true) / count;
+		const double tolerance = 5 * std::sqrt(chance * (1 - chance) / count); //5 standard deviations, 0 for chances 0 and 1
+		report.check(std::abs(rate - chance) <= tolerance, "random_fill_bernoulli chance " + std::to_string(chance) + " rate " + std::to_string(rate));
+	}
+
+	//the same seed fills the same numbers
+	Random first(seed), second(seed);
+	std::vector<int> ints_second(count);
+	std::vector<double> doubles_second(count);
+	std::unique_ptr<bool[]> rolls_second(new bool[count]);
+	first.FillInts(ints.data(), count, -7, 1000);
+	second.FillInts(ints_second.data(), count, -7, 1000);
+	first.FillDoubles(doubles.data(), count);
+	second.FillDoubles(doubles_second.data(), count);
+	first.FillRolls(rolls.get(), count, 0.4);
+	second.FillRolls(rolls_second.get(), count, 0.4);
+	report.check(ints == ints_second && doubles == doubles_second && std::equal(rolls.get(), rolls.get() + count, rolls_second.get()), "Random Fill functions with the same seed");
+
+	return report.summary();
+}
+
+//state of xoshiro256** as vector over GF(2), bit b of word w is bit 64 * w + b
+typedef std::array<uint64_t, 4> XoshiroBits;
+
+//multiplies vector by matrix over GF(2), column c of matrix is image of c-th unit vector
+inline XoshiroBits gf2_apply(const std::vector<XoshiroBits>& matrix, const XoshiroBits& vector)
+{
+	XoshiroBits result = { 0, 0, 0, 0 };
+	for (size_t bit = 0; bit < 256; bit++)
+		if ((vector[bit / 64] >> (bit % 64)) & 1)
+			for (int word = 0; word < 4; word++)
+				result[word] ^= matrix[bit][word];
+	return result;
+}
+
+//matrix of state transition of xoshiro256** advanced by 2^power numbers, made by squaring matrix of one step
+inline std::vector<XoshiroBits> xoshiro_advance_matrix(const int& power)
+{
+	std::vector<XoshiroBits> matrix(256);
+	Xoshiro256StarStar engine;
+	for (size_t bit = 0; bit < 256; bit++)
+	{
+		XoshiroBits unit = { 0, 0, 0, 0 };
+		unit[bit / 64] = 1ull << (bit % 64);
+		engine.set_state(unit.data());
+		engine();
+		engine.get_state(matrix[bit].data());
+	}
+	for (int x = 0; x < power; x++)
+	{
+		std::vector<XoshiroBits> squared(256);
+		for (size_t bit = 0; bit < 256; bit++)
+			squared[bit] = gf2_apply(matrix, matrix[bit]);
+		matrix.swap(squared);
+	}
+	return matrix;
+}
+
+/// <summary>
+/// Test of streams: Philox4x32-10 is compared with known-answer vectors of Random123, its at, seek, discard and tell have
+/// to agree with sequential numbers, jump() and long_jump() of xoshiro256** have to equal advancing state by 2^128 and 2^192
+/// numbers (transition matrix over GF(2) squared 128 and 192 times), streams of SeedStream have to differ and repeat,
+/// and parallel_random_blocks has to give the same output for any thread count
+/// </summary>
+/// <param name="seed">Seed of generated numbers</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_random_streams(const uint64_t& seed = 20240601)
+{
+	TestReport report("random streams");
+
+	//counter, key and expected output from kat_vectors of Random123
+	const uint32_t vectors[3][10] = {
+		{ 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+		{ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd },
+		{ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0, 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } };
+	for (const auto& vector : vectors)
+	{
+		uint32_t ctr[4] = { vector[0], vector[1], vector[2], vector[3] };
+		Philox4x32::block(ctr, vector + 4);
+		report.check(std::equal(ctr, ctr + 4, vector + 6), "Philox4x32-10 known-answer vector, counter " + std::to_string(vector[0]));
+	}
+
+	//random access agrees with sequential numbers, also at odd positions inside block
+	Philox4x32 philox(seed, 7);
+	std::vector<uint64_t> sequence(1003);
+	for (uint64_t& number : sequence)
+		number = philox();
+	bool same_at = true;
+	for (size_t x = 0; x < sequence.size(); x++)
+		same_at &= philox.at(x) == sequence[x];
+	report.check(same_at, "Philox4x32 at equals sequential numbers");
+	bool same_seek = true;
+	for (const uint64_t index : { 0, 1, 2, 501, 998, 999 })
+	{
+		philox.seek(index);
+		same_seek &= philox.tell() == index && philox() == sequence[index];
+		philox.discard(1);
+		same_seek &= philox.tell() == index + 2 && philox() == sequence[index + 2];
+	}
+	report.check(same_seek, "Philox4x32 seek, discard and tell agree with sequential numbers");
+	Philox4x32 other_stream = Philox4x32::stream(seed, 8);
+	report.check(other_stream() != sequence[0] && other_stream() != sequence[1], "Philox4x32 streams differ");
+
+	//jumps equal advancing by 2^128 and 2^192 numbers
+	for (const bool long_jump : { false, true })
+	{
+		const std::vector<XoshiroBits> matrix = xoshiro_advance_matrix(long_jump ? 192 : 128);
+		Xoshiro256StarStar engine(seed);
+		XoshiroBits state, jumped;
+		engine.get_state(state.data());
+		if (long_jump)
+			engine.long_jump();
+		else
+			engine.jump();
+		engine.get_state(jumped.data());
+		report.check(jumped == gf2_apply(matrix, state), long_jump ? "long_jump advances by 2^192 numbers" : "jump advances by 2^128 numbers");
+	}
+
+	//streams of SeedStream differ and repeat in every thread
+	auto stream_numbers = [seed](const uint64_t& index) {
+		std::vector<uint64_t> numbers;
+		std::thread thread([&]() {
+			StaticRandom::SeedStream(seed, index);
+			for (int x = 0; x < 100; x++)
+				numbers.push_back((uint64_t)StaticRandom::NextLong(0, LLONG_MAX));
+			StaticRandom::SeedRandomly();
+		});
+		thread.join();
+		return numbers;
+	};
+	const std::vector<uint64_t> stream0 = stream_numbers(0), stream1 = stream_numbers(1), stream2 = stream_numbers(2);
+	report.check(stream0 != stream1 && stream1 != stream2 && stream0 != stream2, "SeedStream streams differ");
+	report.check(stream1 == stream_numbers(1), "SeedStream stream repeats");
+
+	//output depends only on seed and block size, block b is Philox4x32 stream b
+	const size_t size = 10007, block_size = 100;
+	auto fill = [&](const unsigned int& thread_count) {
+		std::vector<uint64_t> numbers(size);
+		parallel_random_blocks(size, block_size, seed, [&](Philox4x32& engine, const size_t& begin, const size_t& end) {
+			for (size_t x = begin; x < end; x++)
+				numbers[x] = engine();
+		}, thread_count);
+		return numbers;
+	};
+	const std::vector<uint64_t> single = fill(1);
+	bool blocks_match = true;
+	for (size_t block = 0; block * block_size < size; block++)
+	{
+		Philox4x32 engine(seed, block);
+		for (size_t x = block * block_size; x < std::min(size, (block + 1) * block_size); x++)
+			blocks_match &= single[x] == engine();
+	}
+	report.check(blocks_match, "parallel_random_blocks gives block b Philox4x32 stream b");
+	for (const unsigned int thread_count : { 2u, 3u, 8u, 0u })
+		report.check(fill(thread_count) == single, "parallel_random_blocks with " + std::to_string(thread_count) + " threads equals 1 thread");
+
+	return report.summary();
+}
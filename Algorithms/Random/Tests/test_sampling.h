@@ -0,0 +1,162 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include "Utility/testing.h"
+#include "Algorithms/Random/array_permutations.h"
+#include "Algorithms/Random/reservoir_sampling.h"
+
+//checks that sample has expected size, distinct items and only items of range [0, size)
+inline bool valid_sample(std::vector<int> sample, const size_t& expected_size, const int& size)
+{
+	std::sort(sample.begin(), sample.end());
+	return sample.size() == expected_size && std::adjacent_find(sample.begin(), sample.end()) == sample.end()
+		&& (sample.empty() || (sample.front() >= 0 && sample.back() < size));
+}
+
+//chance that item is in weighted sample of k items without replacement, items are drawn one by one with chance proportional
+//to weight, which is distribution of k largest keys u^(1/weight). Computed over subsets of drawn items, so weights are few
+inline std::vector<double> weighted_inclusion(const std::vector<double>& weights, const size_t& k)
+{
+	const size_t n = weights.size();
+	std::vector<double> subset_chance(size_t(1) << n, 0), subset_weight(size_t(1) << n, 0), inclusion(n, 0);
+	subset_chance[0] = 1;
+	const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+	for (size_t subset = 1; subset < subset_chance.size(); subset++)
+	{
+		size_t bits = 0;
+		for (size_t item = 0; item < n; item++)
+			if ((subset >> item) & 1)
+			{
+				const size_t before = subset & ~(size_t(1) << item);
+				subset_weight[subset] = subset_weight[before] + weights[item];
+				subset_chance[subset] += subset_chance[before] * weights[item] / (total - subset_weight[before]);
+				bits++;
+			}
+		if (bits == k)
+			for (size_t item = 0; item < n; item++)
+				if ((subset >> item) & 1)
+					inclusion[item] += subset_chance[subset];
+	}
+	return inclusion;
+}
+
+/// <summary>
+/// Test of sampling: ReservoirSampler (Algorithm L), WeightedReservoirSampler (A-ExpJ), floyd_sample and random_sample have to
+/// return k distinct items of input (or all of them for shorter input), every item has to be included equally likely, and
+/// weighted samples have to include items with chance given by weights: proportional for k = 1 (chi-square), and chance of
+/// drawing without replacement for larger k (within 5 standard deviations). Item 0 has weight 0 and must never be sampled
+/// </summary>
+/// <param name="seed">Seed of generated numbers</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_sampling(const uint64_t& seed = 20240601)
+{
+	TestReport report("sampling");
+	Xoshiro256StarStar engine(seed);
+
+	bool sizes = true, weighted_sizes = true, floyd_sizes = true;
+	for (const size_t k : { 0, 1, 5, 100 })
+		for (const size_t size : { 0, 3, 5, 100, 1000, 10007 })
+		{
+			std::vector<int> arr(size);
+			std::iota(arr.begin(), arr.end(), 0);
+			const size_t expected = std::min(k, size);
+
+			ReservoirSampler<int> single(k, engine()), range(k, engine());
+			for (const int& item : arr)
+				single.Add(item);
+			for (size_t begin = 0; begin < size; begin += std::min<size_t>(size - begin, 1 + begin % 97))
+				range.AddRange(arr.data() + begin, std::min<size_t>(size - begin, 1 + begin % 97));
+			sizes &= valid_sample(single.GetSample(), expected, (int)size) && valid_sample(range.GetSample(), expected, (int)size);
+			sizes &= single.GetCount() == size && range.GetCount() == size;
+
+			WeightedReservoirSampler<int> weighted(k, engine());
+			for (const int& item : arr)
+				weighted.Add(item, 1 + item % 7);
+			weighted_sizes &= valid_sample(weighted.GetSample(), expected, (int)size);
+
+			int* floyd = floyd_sample(arr.data(), size, k, engine);
+			int* sample = random_sample(arr.data(), size, k);
+			if (k > size)
+				floyd_sizes &= floyd == nullptr && sample == nullptr;
+			else
+				floyd_sizes &= valid_sample(std::vector<int>(floyd, floyd + k), k, (int)size) && valid_sample(std::vector<int>(sample, sample + k), k, (int)size);
+			delete[] floyd;
+			delete[] sample;
+		}
+	report.check(sizes, "ReservoirSampler returns min(k, n) distinct items of input");
+	report.check(weighted_sizes, "WeightedReservoirSampler returns min(k, n) distinct items of input");
+	report.check(floyd_sizes, "floyd_sample and random_sample return k distinct items of input");
+
+	//every item is included with chance k/n, AddRange skips over most of 200 items
+	const size_t runs = 20000, k = 5;
+	std::vector<int> arr(200);
+	std::iota(arr.begin(), arr.end(), 0);
+	for (const size_t size : { (size_t)20, (size_t)200 })
+	{
+		std::vector<size_t> reservoir_counts(size, 0), range_counts(size, 0), floyd_counts(size, 0);
+		for (size_t run = 0; run < runs; run++)
+		{
+			ReservoirSampler<int> single(k, engine()), range(k, engine());
+			for (size_t x = 0; x < size; x++)
+				single.Add(arr[x]);
+			range.AddRange(arr.data(), size);
+			for (const int& item : single.GetSample())
+				reservoir_counts[item]++;
+			for (const int& item : range.GetSample())
+				range_counts[item]++;
+			int* floyd = floyd_sample(arr.data(), size, k, engine);
+			for (size_t x = 0; x < k; x++)
+				floyd_counts[floyd[x]]++;
+			delete[] floyd;
+		}
+		const double critical = chi_square_critical(size - 1);
+		const std::string suffix = " of " + std::to_string(size) + " items is uniform, chi-square ";
+		report.check(chi_square(reservoir_counts) < critical, "ReservoirSampler inclusion" + suffix + std::to_string(chi_square(reservoir_counts)));
+		report.check(chi_square(range_counts) < critical, "ReservoirSampler AddRange inclusion" + suffix + std::to_string(chi_square(range_counts)));
+		report.check(chi_square(floyd_counts) < critical, "floyd_sample inclusion" + suffix + std::to_string(chi_square(floyd_counts)));
+	}
+
+	//single item is chosen with chance proportional to weight, weights 0..49
+	std::vector<double> weights(50);
+	std::iota(weights.begin(), weights.end(), 0.0);
+	const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+	std::vector<size_t> chosen(weights.size(), 0);
+	for (size_t run = 0; run < 50000; run++)
+	{
+		WeightedReservoirSampler<int> weighted(1, engine());
+		weighted.AddRange(arr.data(), weights.data(), weights.size());
+		chosen[weighted.GetSample()[0]]++;
+	}
+	std::vector<size_t> positive(chosen.begin() + 1, chosen.end());
+	std::vector<double> chances(weights.begin() + 1, weights.end());
+	for (double& chance : chances)
+		chance /= total;
+	report.check(chosen[0] == 0, "WeightedReservoirSampler never samples item of weight 0");
+	report.check(chi_square(positive, chances) < chi_square_critical(positive.size() - 1), "WeightedReservoirSampler k=1 follows weights, chi-square " + std::to_string(chi_square(positive, chances)));
+
+	//inclusion in sample of 3 from 10 items, weights spread over 4 orders of magnitude
+	const std::vector<double> spread = { 0, 0.01, 0.1, 0.5, 1, 2, 5, 10, 30, 100 };
+	const std::vector<double> inclusion = weighted_inclusion(spread, 3);
+	std::vector<size_t> included(spread.size(), 0);
+	const size_t weighted_runs = 100000;
+	for (size_t run = 0; run < weighted_runs; run++)
+	{
+		WeightedReservoirSampler<int> weighted(3, engine());
+		weighted.AddRange(arr.data(), spread.data(), spread.size());
+		for (const int& item : weighted.GetSample())
+			included[item]++;
+	}
+	bool follows = true;
+	for (size_t item = 0; item < spread.size(); item++)
+	{
+		const double deviation = std::sqrt(weighted_runs * inclusion[item] * (1 - inclusion[item]));
+		follows &= std::abs((double)included[item] - weighted_runs * inclusion[item]) <= 5 * deviation;
+	}
+	report.check(follows, "WeightedReservoirSampler k=3 inclusion follows chances of drawing without replacement");
+
+	return report.summary();
+}
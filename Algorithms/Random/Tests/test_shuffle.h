@@ -0,0 +1,110 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include "Utility/testing.h"
+#include "Algorithms/Random/array_permutations.h"
+
+//index of permutation of items 0..size-1 in lexicographic order (Lehmer code)
+inline size_t permutation_rank(const int* arr, const size_t& size)
+{
+	size_t rank = 0;
+	for (size_t x = 0; x < size; x++)
+	{
+		size_t smaller = 0;
+		for (size_t y = x + 1; y < size; y++)
+			smaller += arr[y] < arr[x];
+		rank = rank * (size - x) + smaller;
+	}
+	return rank;
+}
+
+/// <summary>
+/// Test of shuffles: fisher_yates_shuffle, fast_shuffle, scatter_shuffle and parallel_shuffle have to output permutation
+/// of input for sizes around bucket size, every permutation of 5 items has to be equally likely (chi-square over 120
+/// permutations) and every item has to land at every position equally likely. Scatter and parallel shuffles get small
+/// bucket_items, so scatter paths are taken instead of Fisher-Yates fallback. parallel_shuffle with fixed seed has to give
+/// the same result for any thread count, also for arrays of several chunks
+/// </summary>
+/// <param name="seed">Seed of generated numbers</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_shuffle(const uint64_t& seed = 20240601)
+{
+	TestReport report("shuffle");
+	const size_t bucket_items = 4;
+
+	//shuffle(arr, size, run), run makes seed of parallel_shuffle different in every run
+	Xoshiro256StarStar engine(seed);
+	StaticRandom::Seed(seed);
+	const std::vector<std::pair<std::string, std::function<void(int*, size_t, size_t)>>> shuffles = {
+		{ "fisher_yates_shuffle", [&](int* arr, size_t size, size_t) { fisher_yates_shuffle(arr, size, engine); } },
+		{ "fast_shuffle", [&](int* arr, size_t size, size_t) { fast_shuffle(arr, size); } },
+		{ "scatter_shuffle", [&](int* arr, size_t size, size_t) { scatter_shuffle(arr, size, engine, bucket_items); } },
+		{ "parallel_shuffle", [&](int* arr, size_t size, size_t run) { parallel_shuffle(arr, size, seed + run, 2, bucket_items); } } };
+
+	for (const auto& shuffle : shuffles)
+	{
+		const std::string& name = shuffle.first;
+
+		bool permutation = true;
+		for (const size_t size : { 0, 1, 2, 3, 4, 5, 8, 9, 100, 1000, 4097 })
+		{
+			std::vector<int> arr(size);
+			std::iota(arr.begin(), arr.end(), 0);
+			shuffle.second(arr.data(), size, size);
+			std::sort(arr.begin(), arr.end());
+			for (size_t x = 0; x < size; x++)
+				permutation &= arr[x] == (int)x;
+		}
+		report.check(permutation, name + " outputs permutation of input");
+
+		//5 items are more than bucket_items, so every run goes through scatter
+		const size_t runs = 120 * 500;
+		std::vector<size_t> permutations(120, 0);
+		for (size_t run = 0; run < runs; run++)
+		{
+			int arr[5] = { 0, 1, 2, 3, 4 };
+			shuffle.second(arr, 5, run);
+			permutations[permutation_rank(arr, 5)]++;
+		}
+		report.check(chi_square(permutations) < chi_square_critical(119), name + " permutations of 5 items are uniform, chi-square " + std::to_string(chi_square(permutations)));
+
+		//positions of the first and the last item in array of several levels of buckets
+		const size_t size = 100;
+		std::vector<size_t> first_positions(size, 0), last_positions(size, 0);
+		std::vector<int> arr(size);
+		for (size_t run = 0; run < 5000; run++)
+		{
+			std::iota(arr.begin(), arr.end(), 0);
+			shuffle.second(arr.data(), size, run);
+			first_positions[std::find(arr.begin(), arr.end(), 0) - arr.begin()]++;
+			last_positions[std::find(arr.begin(), arr.end(), (int)size - 1) - arr.begin()]++;
+		}
+		report.check(chi_square(first_positions) < chi_square_critical(size - 1) && chi_square(last_positions) < chi_square_critical(size - 1),
+			name + " positions of items are uniform, chi-square " + std::to_string(chi_square(first_positions)) + " and " + std::to_string(chi_square(last_positions)));
+	}
+	StaticRandom::SeedRandomly();
+
+	//the same seed gives the same permutation for any thread count, 3 chunks of 2^20 items with default bucket size
+	for (const size_t size : { (size_t)1000, (size_t)(3 << 20) - 12345 })
+	{
+		const size_t items = size == 1000 ? bucket_items : 0;
+		std::vector<int> single(size);
+		std::iota(single.begin(), single.end(), 0);
+		parallel_shuffle(single.data(), size, seed, 1, items);
+		bool same = true;
+		for (const unsigned int thread_count : { 2u, 3u, 8u, 0u })
+		{
+			std::vector<int> arr(size);
+			std::iota(arr.begin(), arr.end(), 0);
+			parallel_shuffle(arr.data(), size, seed, thread_count, items);
+			same &= arr == single;
+		}
+		report.check(same, "parallel_shuffle of " + std::to_string(size) + " items is the same for 1, 2, 3, 8 and all threads");
+	}
+
+	return report.summary();
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include "Utility/testing.h"
+#include "Algorithms/Random/array_permutations.h"
+#include "Algorithms/Random/hyperloglog.h"
+#include "Algorithms/Random/frequency_sketches.h"
+
+/// <summary>
+/// Test of HyperLogLog: relative error at precisions 8 to 16 has to stay within 4 standard errors 1.04/sqrt(2^precision)
+/// from tens to millions of distinct items, sparse representation (up to 2^precision / 4 entries) has to be nearly exact,
+/// estimate must not jump when sketch turns dense, and merge of sparse and dense sketches in any combination has to give
+/// exactly the estimate of one sketch that got all items
+/// </summary>
+/// <param name="seed">Seed of hash of items</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_hyperloglog(const uint64_t& seed = 20240601)
+{
+	TestReport report("hyperloglog");
+
+	for (const int precision : { 8, 12, 14, 16 })
+	{
+		const double m = (double)(size_t(1) << precision), tolerance = 4 * 1.04 / std::sqrt(m);
+		HyperLogLog<uint64_t> sketch(precision, seed);
+		bool within = true, sparse_exact = true;
+		std::string worst;
+		uint64_t added = 0;
+		for (const uint64_t distinct : { 10, 100, 1000, 3000, 10000, 30000, 100000, 300000, 1000000, 3000000 })
+		{
+			for (; added < distinct; added++)
+				sketch.Add(added);
+			const double estimate = sketch.Estimate(), error = std::abs(estimate - distinct) / distinct;
+			if (sketch.IsSparse())
+				sparse_exact &= error < 0.01;
+			else if (error > tolerance)
+			{
+				within = false;
+				worst += " " + std::to_string(distinct) + " -> " + std::to_string(estimate);
+			}
+		}
+		report.check(within, "precision " + std::to_string(precision) + " relative error within " + std::to_string(tolerance) + worst);
+		report.check(sparse_exact, "precision " + std::to_string(precision) + " sparse estimate within 1%");
+
+		//estimate just before and just after sketch turns dense
+		HyperLogLog<uint64_t> growing(precision, seed);
+		uint64_t count = 0;
+		double sparse_estimate = 0;
+		while (growing.IsSparse())
+		{
+			sparse_estimate = growing.Estimate();
+			for (uint64_t x = 0; x < 16; x++)
+				growing.Add(count++);
+		}
+		const double dense_estimate = growing.Estimate();
+		report.check(count > m / 4 && count <= m, "precision " + std::to_string(precision) + " turns dense after " + std::to_string(count) + " items");
+		report.check(std::abs(dense_estimate - sparse_estimate - 16) <= tolerance * count, "precision " + std::to_string(precision) + " estimate "
+			+ std::to_string(sparse_estimate) + " -> " + std::to_string(dense_estimate) + " when sketch turns dense");
+
+		//merge gives the same registers as one sketch, conversion of sparse entries to dense registers is exact
+		const uint64_t sizes[2] = { (uint64_t)m / 16, (uint64_t)m * 4 }; //sparse, dense
+		bool same = true;
+		for (const uint64_t first : sizes)
+			for (const uint64_t second : sizes)
+			{
+				HyperLogLog<uint64_t> a(precision, seed), b(precision, seed), all(precision, seed);
+				for (uint64_t x = 0; x < first; x++)
+					a.Add(x);
+				for (uint64_t x = first / 2; x < first / 2 + second; x++) //halves overlap
+					b.Add(x);
+				for (uint64_t x = 0; x < std::max(first, first / 2 + second); x++)
+					all.Add(x);
+				same &= a.Merge(b) && a.Estimate() == all.Estimate();
+			}
+		report.check(same, "precision " + std::to_string(precision) + " merge of sparse and dense sketches equals one sketch");
+	}
+
+	HyperLogLog<uint64_t> a(12, seed), other_precision(13, seed), other_seed(12, seed + 1);
+	report.check(!a.Merge(other_precision) && !a.Merge(other_seed), "merge with different precision or seed fails");
+
+	return report.summary();
+}
+
+/// <summary>
+/// Test of frequency sketches on Zipf stream (item i occurs 100000/(i+1) times) in random order:
+/// Count-Min never underestimates and overestimates by more than epsilon * total count for at most delta of items,
+/// Count-Sketch errs by more than 3 * sqrt(F2 / width) (F2 is sum of squared counts) for at most 1.4% of items
+/// (row fails with chance at most 1/9 by Chebyshev's inequality, median of 5 rows fails if 3 rows fail),
+/// AddRange gives the same counters as Add and merge of two halves of stream gives the same estimates as one sketch
+/// </summary>
+/// <param name="seed">Seed of hash and of order of stream</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_frequency_sketches(const uint64_t& seed = 20240601)
+{
+	TestReport report("frequency sketches");
+
+	const int distinct = 10000;
+	std::vector<uint32_t> counts(distinct);
+	std::vector<int> items(distinct), stream;
+	double total = 0, squares = 0;
+	for (int item = 0; item < distinct; item++)
+	{
+		items[item] = item;
+		counts[item] = 100000 / (item + 1);
+		total += counts[item];
+		squares += (double)counts[item] * counts[item];
+		stream.insert(stream.end(), counts[item], item);
+	}
+	Xoshiro256StarStar engine(seed);
+	fisher_yates_shuffle(stream.data(), stream.size(), engine);
+	const size_t half = stream.size() / 2;
+
+	const double epsilon = 0.001, delta = 0.01;
+	CountMinSketch<int> count_min = CountMinSketch<int>::WithError(epsilon, delta, seed), by_counts = count_min, first = count_min, second = count_min;
+	for (const int& item : stream)
+		count_min.Add(item);
+	by_counts.AddRange(items.data(), counts.data(), distinct);
+	first.AddRange(stream.data(), half);
+	second.AddRange(stream.data() + half, stream.size() - half);
+	report.check(first.Merge(second), "Count-Min merge of sketches with the same dimensions");
+
+	bool never_under = true, same_range = true, same_merge = true;
+	size_t over_bound = 0;
+	for (int item = 0; item < distinct; item++)
+	{
+		const uint32_t estimate = count_min.Estimate(item);
+		never_under &= estimate >= counts[item];
+		over_bound += estimate - counts[item] > epsilon * total;
+		same_range &= by_counts.Estimate(item) == estimate;
+		same_merge &= first.Estimate(item) == estimate;
+	}
+	report.check(never_under, "Count-Min never underestimates");
+	report.check(over_bound <= delta * distinct, "Count-Min exceeds epsilon * total for " + std::to_string(over_bound) + " of " + std::to_string(distinct) + " items");
+	report.check(same_range, "Count-Min AddRange with counts equals Add");
+	report.check(same_merge, "Count-Min merge of halves equals one sketch");
+
+	const size_t width = 1000, depth = 5;
+	CountSketch<int> count_sketch(width, depth, seed), ranged(width, depth, seed), first_half(width, depth, seed), second_half(width, depth, seed);
+	for (int item = 0; item < distinct; item++)
+		count_sketch.Add(item, (int32_t)counts[item]);
+	ranged.AddRange(stream.data(), stream.size());
+	first_half.AddRange(stream.data(), half);
+	second_half.AddRange(stream.data() + half, stream.size() - half);
+	report.check(first_half.Merge(second_half), "Count-Sketch merge of sketches with the same dimensions");
+
+	const double bound = 3 * std::sqrt(squares / width);
+	size_t over = 0;
+	bool same_add = true, same_halves = true;
+	for (int item = 0; item < distinct; item++)
+	{
+		const int32_t estimate = count_sketch.Estimate(item);
+		over += std::abs((double)estimate - counts[item]) > bound;
+		same_add &= ranged.Estimate(item) == estimate;
+		same_halves &= first_half.Estimate(item) == estimate;
+	}
+	report.check(over <= 0.014 * distinct, "Count-Sketch exceeds 3 * sqrt(F2 / width) = " + std::to_string(bound) + " for " + std::to_string(over) + " of " + std::to_string(distinct) + " items");
+	report.check(same_add, "Count-Sketch AddRange equals Add with counts");
+	report.check(same_halves, "Count-Sketch merge of halves equals one sketch");
+
+	CountMinSketch<int> other_width(count_min.GetWidth() + 1, count_min.GetDepth(), seed);
+	CountSketch<int> other_seed(width, depth, seed + 1);
+	report.check(!count_min.Merge(other_width) && !count_sketch.Merge(other_seed), "merge with different dimensions or seed fails");
+
+	return report.summary();
+}
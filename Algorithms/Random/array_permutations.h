@@ -1,4 +1,10 @@
 #pragma once
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <unordered_set>
 #include "random.h"
 
 //randomly permutes given array
@@ -52,23 +58,250 @@ void permute_by_cycle(T* arr, const size_t& size)
 	delete[] copy; //free memory
 }
 
-//creates and returns new array of size = size, with random permutation of arr, if size > arr_size returns nullptr
-template<class T>
-T* random_sample(T* arr, const size_t& arr_size, const size_t& size)
+/// <summary>
+/// Floyd's sampling, creates and returns new array with size items chosen uniformly at random from arr, without repetition
+/// Source array is never copied, uses O(size) memory and exactly size random numbers. Items are returned in order in which they were drawn,
+/// which is not uniformly random, shuffle output if order matters. If size > arr_size returns nullptr
+/// </summary>
+template<class T, class Engine>
+T* floyd_sample(const T* arr, const size_t& arr_size, const size_t& size, Engine& engine)
 {
 	if (size > arr_size)
 		return nullptr;
 
-	T* copy = new T[arr_size]; //create copy, and permute it
 	T* output = new T[size];
-	for (int x = 0; x < arr_size; x++)
-		copy[x] = arr[x];
+	std::unordered_set<size_t> chosen;
+	chosen.reserve(size);
 
-	randomly_permute(copy, arr_size);
-	for (int x = 0; x < size; x++)
-		output[x] = copy[x];
+	size_t count = 0;
+	for (size_t j = arr_size - size; j < arr_size; j++)
+	{
+		size_t t = (size_t)random_bounded(engine, (uint64_t)j + 1);
+		if (!chosen.insert(t).second) //t was already chosen, j was not, since it is larger than every index so far
+		{
+			chosen.insert(j);
+			t = j;
+		}
+		output[count++] = arr[t];
+	}
+	return output;
+}
+
+/// <summary>
+/// Fisher-Yates shuffle using given engine, generates uniformly random permutation
+/// Every index is drawn with random_bounded, so there is no modulo bias and no call to std::random_device
+/// </summary>
+template<class T, class Engine>
+void fisher_yates_shuffle(T* arr, const size_t& size, Engine& engine)
+{
+	for (size_t x = size; x > 1; x--)
+		std::swap(arr[x - 1], arr[random_bounded(engine, x)]);
+}
+
+/// <summary>
+/// Fisher-Yates shuffle using engine of calling thread, same results as randomly_permute, but much faster and works for arrays over 2^31 items
+/// </summary>
+template<class T>
+void fast_shuffle(T* arr, const size_t& size)
+{
+	fisher_yates_shuffle(arr, size, StaticRandom::GetEngine());
+}
 
-	delete[] copy;
+//creates and returns new array of size = size, with random permutation of size items of arr, if size > arr_size returns nullptr
+//uses Floyd's sampling followed by shuffle of the output, so it needs O(size) memory instead of copying arr
+template<class T>
+T* random_sample(T* arr, const size_t& arr_size, const size_t& size)
+{
+	T* output = floyd_sample(arr, arr_size, size, StaticRandom::GetEngine());
+	if (output != nullptr)
+		fisher_yates_shuffle(output, size, StaticRandom::GetEngine());
 	return output;
 }
 
+/// <summary>
+/// Draws bucket indexes in range [0, 2^bits), single 64 bit number gives 64/bits indexes
+/// Used by scatter shuffles, copy of this object regenerates the same indexes
+/// </summary>
+template<class Engine>
+class ShuffleBucketDraws
+{
+private:
+	Engine engine;
+	int bits;
+	uint64_t mask;
+	uint64_t current = 0;
+	int left = 0; //indexes left in current
+public:
+	ShuffleBucketDraws(const Engine& _engine, const int& _bits) : engine(_engine), bits(_bits), mask((1ull << _bits) - 1) {}
+
+	size_t next()
+	{
+		if (left == 0)
+		{
+			current = engine();
+			left = 64 / bits;
+		}
+		size_t bucket = (size_t)(current & mask);
+		current >>= bits;
+		left--;
+		return bucket;
+	}
+};
+
+//number of bits of bucket index for scatter shuffle, so that buckets have about bucket_items items (at most 1024 buckets)
+inline int shuffle_bucket_bits(const size_t& size, const size_t& bucket_items)
+{
+	int bits = 1;
+	while (bits < 10 && (size >> bits) > bucket_items)
+		bits++;
+	return bits;
+}
+
+//default size of scatter shuffle buckets, bucket should fit into L2 cache
+template<class T>
+size_t shuffle_bucket_items() { return std::max<size_t>(1024, (256 * 1024) / sizeof(T)); }
+
+/// <summary>
+/// Scatter shuffle (Sanders), generates uniformly random permutation with cache friendly memory access
+/// Every item is moved to random bucket (at most 1024 sequential write streams), then every bucket is shuffled while it is in cache
+/// Since items are assigned to buckets independently and uniformly and every bucket is shuffled uniformly, whole permutation is uniform
+/// Needs additional array of size items
+/// </summary>
+/// <param name="bucket_items">Arrays up to this size are shuffled with Fisher-Yates, 0 -> chosen from size of T</param>
+template<class T, class Engine>
+void scatter_shuffle(T* arr, const size_t& size, Engine& engine, size_t bucket_items = 0)
+{
+	if (bucket_items == 0)
+		bucket_items = shuffle_bucket_items<T>();
+	if (size <= bucket_items)
+	{
+		fisher_yates_shuffle(arr, size, engine);
+		return;
+	}
+
+	const int bits = shuffle_bucket_bits(size, bucket_items);
+	const size_t bucket_count = size_t(1) << bits;
+	const ShuffleBucketDraws<Xoshiro256StarStar> draws(Xoshiro256StarStar(engine()), bits); //copies of draws give the same buckets
+
+	//count items in every bucket, then turn counts into bucket beginnings
+	std::vector<size_t> offsets(bucket_count + 1, 0);
+	ShuffleBucketDraws<Xoshiro256StarStar> counting = draws;
+	for (size_t x = 0; x < size; x++)
+		offsets[counting.next() + 1]++;
+	for (size_t b = 1; b <= bucket_count; b++)
+		offsets[b] += offsets[b - 1];
+
+	//scatter items into buckets
+	T* buffer = new T[size];
+	std::vector<size_t> positions(offsets.begin(), offsets.end() - 1);
+	ShuffleBucketDraws<Xoshiro256StarStar> scattering = draws;
+	for (size_t x = 0; x < size; x++)
+		buffer[positions[scattering.next()]++] = std::move(arr[x]);
+
+	//shuffle every bucket and move it back, buckets that are still too big are scattered again
+	for (size_t b = 0; b < bucket_count; b++)
+	{
+		scatter_shuffle(buffer + offsets[b], offsets[b + 1] - offsets[b], engine, bucket_items);
+		std::move(buffer + offsets[b], buffer + offsets[b + 1], arr + offsets[b]);
+	}
+
+	delete[] buffer;
+}
+
+/// <summary>
+/// Scatter shuffle using engine of calling thread, see <see cref="scatter_shuffle"/>
+/// </summary>
+template<class T>
+void scatter_shuffle(T* arr, const size_t& size)
+{
+	scatter_shuffle(arr, size, StaticRandom::GetEngine());
+}
+
+/// <summary>
+/// Multi threaded scatter shuffle, generates uniformly random permutation
+/// Array is split into fixed size chunks, threads count items of their chunks in every bucket, scatter them into buckets
+/// at offsets given by prefix sums, then shuffle buckets in parallel
+/// Chunk and bucket randomness comes from Philox4x32 streams chosen by chunk/bucket index, so for given seed
+/// result is the same for any number of threads
+/// </summary>
+/// <param name="thread_count">Number of threads, 0 -> std::thread::hardware_concurrency()</param>
+/// <param name="bucket_items">Arrays up to this size are shuffled with Fisher-Yates, 0 -> chosen from size of T</param>
+template<class T>
+void parallel_shuffle(T* arr, const size_t& size, const uint64_t& seed, unsigned int thread_count = 0, size_t bucket_items = 0)
+{
+	if (bucket_items == 0)
+		bucket_items = shuffle_bucket_items<T>();
+	if (size <= bucket_items)
+	{
+		Philox4x32 engine(seed);
+		fisher_yates_shuffle(arr, size, engine);
+		return;
+	}
+	if (thread_count == 0)
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+	const int bits = shuffle_bucket_bits(size, bucket_items);
+	const size_t bucket_count = size_t(1) << bits;
+	const size_t chunk_size = size_t(1) << 20;
+	const size_t chunk_count = (size + chunk_size - 1) / chunk_size;
+
+	//runs func(index) for index in [0, count) from thread_count threads
+	auto run_parallel = [&](const size_t& count, const std::function<void(size_t)>& func) {
+		std::atomic<size_t> next(0);
+		auto worker = [&]() {
+			for (size_t index = next++; index < count; index = next++)
+				func(index);
+		};
+		std::vector<std::thread> threads;
+		for (unsigned int x = 1; x < thread_count && x < count; x++)
+			threads.emplace_back(worker);
+		worker();
+		for (auto& thread : threads)
+			thread.join();
+	};
+
+	//chunk c uses stream 2c for bucket indexes, bucket b uses stream 2b+1 for shuffling
+	auto chunk_draws = [&](const size_t& chunk) { return ShuffleBucketDraws<Philox4x32>(Philox4x32(seed, 2 * chunk), bits); };
+
+	//counts[chunk * bucket_count + bucket] -> number of items of chunk that go to bucket
+	std::vector<size_t> counts(chunk_count * bucket_count, 0);
+	run_parallel(chunk_count, [&](size_t chunk) {
+		ShuffleBucketDraws<Philox4x32> draws = chunk_draws(chunk);
+		size_t* chunk_counts = counts.data() + chunk * bucket_count;
+		const size_t end = std::min(size, (chunk + 1) * chunk_size);
+		for (size_t x = chunk * chunk_size; x < end; x++)
+			chunk_counts[draws.next()]++;
+	});
+
+	//prefix sums in bucket major order, counts now holds position where chunk starts writing into bucket
+	std::vector<size_t> offsets(bucket_count + 1, 0);
+	size_t sum = 0;
+	for (size_t b = 0; b < bucket_count; b++)
+	{
+		offsets[b] = sum;
+		for (size_t chunk = 0; chunk < chunk_count; chunk++)
+		{
+			size_t count = counts[chunk * bucket_count + b];
+			counts[chunk * bucket_count + b] = sum;
+			sum += count;
+		}
+	}
+	offsets[bucket_count] = size;
+
+	T* buffer = new T[size];
+	run_parallel(chunk_count, [&](size_t chunk) {
+		ShuffleBucketDraws<Philox4x32> draws = chunk_draws(chunk);
+		size_t* positions = counts.data() + chunk * bucket_count;
+		const size_t end = std::min(size, (chunk + 1) * chunk_size);
+		for (size_t x = chunk * chunk_size; x < end; x++)
+			buffer[positions[draws.next()]++] = std::move(arr[x]);
+	});
+
+	run_parallel(bucket_count, [&](size_t b) {
+		Philox4x32 engine(seed, 2 * b + 1);
+		scatter_shuffle(buffer + offsets[b], offsets[b + 1] - offsets[b], engine, bucket_items);
+		std::move(buffer + offsets[b], buffer + offsets[b + 1], arr + offsets[b]);
+	});
+
+	delete[] buffer;
+}
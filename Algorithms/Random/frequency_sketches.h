@@ -0,0 +1,220 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include "random_engines.h"
+#include "Utility/simd.h"
+
+//tables larger than this do not fit in cache, batch updates of such tables prefetch counters
+const size_t sketch_prefetch_bytes = size_t(1) << 20;
+
+/// <summary>
+/// Count-Min sketch, estimates how many times items occured in stream, using depth rows of width counters
+/// Estimate is never smaller than real count and with propability 1 - e^-depth it is larger by at most e/width * total count
+/// Sketches with the same dimensions and seed can be merged, so every thread can fill its own sketch
+/// </summary>
+/// <typeparam name="Counter">Type of counters, counts wrap around on overflow</typeparam>
+template<class T, class Counter = uint32_t, class Hash = std::hash<T>>
+class CountMinSketch
+{
+private:
+	size_t _width = 0;
+	size_t _depth = 0;
+	uint64_t _seed = 0;
+	Hash hash;
+	std::vector<Counter> table; //depth rows of width counters
+
+	uint64_t hash_item(const T& item) { return random_mix64((uint64_t)hash(item) ^ _seed); }
+
+	//counter of item with hash h in given row, rows use double hashing g = h1 + row * h2 mapped to [0, width) by multiply-shift
+	size_t index(const uint64_t& h, const size_t& row)
+	{
+		uint32_t g = (uint32_t)h + (uint32_t)row * ((uint32_t)(h >> 32) | 1);
+		return row * _width + (size_t)(((uint64_t)g * _width) >> 32);
+	}
+
+	//hashes are computed prefetch_distance items ahead and counters of large tables are prefetched,
+	//so cache misses of many items overlap instead of being paid one by one
+	template<class CountOf>
+	void add_range(const T* items, const size_t& count, CountOf count_of)
+	{
+		const size_t prefetch_distance = 16;
+		uint64_t hashes[prefetch_distance];
+		Counter* counters = table.data();
+		const bool prefetch = MemoryUsage() > sketch_prefetch_bytes;
+		for (size_t x = 0; x < count + prefetch_distance; x++)
+		{
+			if (x >= prefetch_distance)
+			{
+				const uint64_t h = hashes[x % prefetch_distance];
+				const Counter value = count_of(x - prefetch_distance);
+				for (size_t row = 0; row < _depth; row++)
+					counters[index(h, row)] += value;
+			}
+			if (x < count)
+			{
+				const uint64_t h = hashes[x % prefetch_distance] = hash_item(items[x]);
+				if (prefetch)
+					for (size_t row = 0; row < _depth; row++)
+						simd_prefetch(counters + index(h, row));
+			}
+		}
+	}
+public:
+	/// <param name="width">Number of counters in row, at most 2^32 - 1</param>
+	/// <param name="depth">Number of rows</param>
+	/// <param name="seed">Seed of hash, only sketches with the same seed can be merged</param>
+	CountMinSketch(const size_t& width, const size_t& depth, const uint64_t& seed = 0x5BD1E995ull) :
+		_width(std::max(size_t(1), std::min(width, (size_t)UINT32_MAX))), _depth(std::max(size_t(1), depth)), _seed(seed), table(_width * _depth, 0) {}
+
+	//creates sketch that overestimates by at most epsilon * total count with propability 1 - delta
+	static CountMinSketch WithError(const double& epsilon, const double& delta, const uint64_t& seed = 0x5BD1E995ull)
+	{
+		return CountMinSketch((size_t)std::ceil(std::exp(1.0) / epsilon), (size_t)std::ceil(std::log(1 / delta)), seed);
+	}
+
+	size_t GetWidth() { return _width; }
+	size_t GetDepth() { return _depth; }
+	size_t MemoryUsage() { return table.size() * sizeof(Counter); }
+
+	void Add(const T& item, const Counter& count = 1)
+	{
+		uint64_t h = hash_item(item);
+		for (size_t row = 0; row < _depth; row++)
+			table[index(h, row)] += count;
+	}
+
+	//adds every item once, prefetches counters of tables larger than cache
+	void AddRange(const T* items, const size_t& count) { add_range(items, count, [](const size_t&) { return Counter(1); }); }
+
+	//adds items[x] counts[x] times
+	void AddRange(const T* items, const Counter* counts, const size_t& count) { add_range(items, count, [counts](const size_t& x) { return counts[x]; }); }
+
+	//returns estimated number of occurences of item, never smaller than real one
+	Counter Estimate(const T& item)
+	{
+		uint64_t h = hash_item(item);
+		Counter result = table[index(h, 0)];
+		for (size_t row = 1; row < _depth; row++)
+			result = std::min(result, table[index(h, row)]);
+		return result;
+	}
+
+	//adds counters of other sketch to this one, returns false and does nothing if dimensions or seeds differ
+	bool Merge(const CountMinSketch& other)
+	{
+		if (other._width != _width || other._depth != _depth || other._seed != _seed)
+			return false;
+
+		Counter* mine = table.data();
+		const Counter* theirs = other.table.data();
+		for (size_t x = 0; x < table.size(); x++)
+			mine[x] += theirs[x];
+		return true;
+	}
+
+	void Clear() { std::fill(table.begin(), table.end(), 0); }
+};
+
+
+/// <summary>
+/// Count-Sketch, estimates how many times items occured in stream, using depth rows of width signed counters
+/// Every row adds count with random sign, estimate is median of rows, so it is unbiased and its error depends on
+/// sum of squares of counts instead of total count, which is much better than Count-Min for skewed streams
+/// Sketches with the same dimensions and seed can be merged
+/// </summary>
+/// <typeparam name="Counter">Signed type of counters</typeparam>
+template<class T, class Counter = int32_t, class Hash = std::hash<T>>
+class CountSketch
+{
+private:
+	size_t _width = 0;
+	size_t _depth = 0;
+	uint64_t _seed = 0;
+	Hash hash;
+	std::vector<Counter> table; //depth rows of width counters
+	std::vector<Counter> row_estimates; //used by Estimate to find median
+
+	uint64_t hash_item(const T& item) { return random_mix64((uint64_t)hash(item) ^ _seed); }
+
+	//every row needs independent index and sign, so hash is mixed again for every row
+	//upper 32 bits choose counter, lowest bit chooses sign
+	uint64_t row_hash(const uint64_t& h, const size_t& row) { return random_mix64(h + row * 0x9E3779B97F4A7C15ull); }
+	size_t index(const uint64_t& g, const size_t& row) { return row * _width + (size_t)(((g >> 32) * _width) >> 32); }
+	static Counter sign(const uint64_t& g) { return (Counter)(1 - (Counter)((g & 1) << 1)); }
+public:
+	/// <param name="width">Number of counters in row, at most 2^32 - 1</param>
+	/// <param name="depth">Number of rows, odd depth makes median exact</param>
+	/// <param name="seed">Seed of hash, only sketches with the same seed can be merged</param>
+	CountSketch(const size_t& width, const size_t& depth, const uint64_t& seed = 0x5BD1E995ull) :
+		_width(std::max(size_t(1), std::min(width, (size_t)UINT32_MAX))), _depth(std::max(size_t(1), depth)), _seed(seed), table(_width * _depth, 0), row_estimates(_depth) {}
+
+	size_t GetWidth() { return _width; }
+	size_t GetDepth() { return _depth; }
+	size_t MemoryUsage() { return table.size() * sizeof(Counter); }
+
+	void Add(const T& item, const Counter& count = 1)
+	{
+		uint64_t h = hash_item(item);
+		for (size_t row = 0; row < _depth; row++)
+		{
+			uint64_t g = row_hash(h, row);
+			table[index(g, row)] += sign(g) * count;
+		}
+	}
+
+	//adds every item once, hashes are computed prefetch_distance items ahead and counters of large tables are prefetched
+	void AddRange(const T* items, const size_t& count)
+	{
+		const size_t prefetch_distance = 16;
+		uint64_t hashes[prefetch_distance];
+		Counter* counters = table.data();
+		const bool prefetch = MemoryUsage() > sketch_prefetch_bytes;
+		for (size_t x = 0; x < count + prefetch_distance; x++)
+		{
+			if (x >= prefetch_distance)
+				for (size_t row = 0; row < _depth; row++)
+				{
+					uint64_t g = row_hash(hashes[x % prefetch_distance], row);
+					counters[index(g, row)] += sign(g);
+				}
+			if (x < count)
+			{
+				const uint64_t h = hashes[x % prefetch_distance] = hash_item(items[x]);
+				if (prefetch)
+					for (size_t row = 0; row < _depth; row++)
+						simd_prefetch(counters + index(row_hash(h, row), row));
+			}
+		}
+	}
+
+	//returns estimated number of occurences of item, median of estimates of rows
+	Counter Estimate(const T& item)
+	{
+		uint64_t h = hash_item(item);
+		for (size_t row = 0; row < _depth; row++)
+		{
+			uint64_t g = row_hash(h, row);
+			row_estimates[row] = sign(g) * table[index(g, row)];
+		}
+		std::nth_element(row_estimates.begin(), row_estimates.begin() + _depth / 2, row_estimates.end());
+		return row_estimates[_depth / 2];
+	}
+
+	//adds counters of other sketch to this one, returns false and does nothing if dimensions or seeds differ
+	bool Merge(const CountSketch& other)
+	{
+		if (other._width != _width || other._depth != _depth || other._seed != _seed)
+			return false;
+
+		Counter* mine = table.data();
+		const Counter* theirs = other.table.data();
+		for (size_t x = 0; x < table.size(); x++)
+			mine[x] += theirs[x];
+		return true;
+	}
+
+	void Clear() { std::fill(table.begin(), table.end(), 0); }
+};
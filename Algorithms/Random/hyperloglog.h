@@ -0,0 +1,213 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <iterator>
+#include "random_engines.h"
+#include "Utility/simd.h"
+
+/// <summary>
+/// HyperLogLog cardinality estimator, estimates number of distinct items in stream using 2^precision registers of 1 byte
+/// Relative standard error is about 1.04/sqrt(2^precision), precision 14 uses 16KB and has error about 0.8%
+/// While there are few distinct items it uses sparse representation (as HyperLogLog++) with 2^25 virtual registers stored as sorted list,
+/// which is exact enough for small cardinalities and uses less memory, it switches to dense registers when list would be larger than them
+/// Sketches with the same precision and seed can be merged, so every thread can fill its own sketch
+/// </summary>
+/// <typeparam name="Hash">Hash of items, its output is mixed again, so std::hash is good enough even for integers</typeparam>
+template<class T, class Hash = std::hash<T>>
+class HyperLogLog
+{
+private:
+	static const int sparse_precision = 25;
+	static const size_t min_buffer = 64; //buffer of sparse entries is flushed when it has max(min_buffer, sparse_limit()/2) entries
+
+	int p = 14;
+	size_t m = size_t(1) << 14;
+	uint64_t _seed = 0;
+	Hash hash;
+
+	bool is_sparse = true;
+	std::vector<uint8_t> registers; //dense registers, empty while sparse
+	std::vector<uint32_t> sparse; //sorted entries (index << 6) | rank with unique index, used while sparse
+	std::vector<uint32_t> buffer; //new unsorted sparse entries
+
+	uint64_t hash_item(const T& item) { return random_mix64((uint64_t)hash(item) ^ _seed); }
+
+	//number of sparse entries after which sketch becomes dense, sparse entry takes 4 bytes, dense register 1 byte
+	size_t sparse_limit() { return m / 4; }
+
+	static uint32_t sparse_entry(const uint64_t& h)
+	{
+		uint32_t index = (uint32_t)(h >> (64 - sparse_precision));
+		uint32_t rank = (uint32_t)bit_leading_zeros(h << sparse_precision) + 1;
+		if (rank > 64 - sparse_precision)
+			rank = 64 - sparse_precision + 1;
+		return (index << 6) | rank;
+	}
+
+	void dense_update(const uint64_t& h)
+	{
+		size_t index = (size_t)(h >> (64 - p));
+		uint8_t rank = (uint8_t)std::min(bit_leading_zeros(h << p) + 1, 64 - p + 1);
+		if (registers[index] < rank)
+			registers[index] = rank;
+	}
+
+	//converts sparse entry to dense register index and rank, same result as dense_update of original hash
+	void dense_update_entry(const uint32_t& entry)
+	{
+		const int extra = sparse_precision - p;
+		uint32_t index = entry >> 6;
+		uint32_t low = index & ((uint32_t(1) << extra) - 1);
+		uint8_t rank = low != 0 ? (uint8_t)(bit_leading_zeros(low) - (64 - extra) + 1) : (uint8_t)(extra + (entry & 63));
+		index >>= extra;
+		if (registers[index] < rank)
+			registers[index] = rank;
+	}
+
+	//moves buffer into sorted list, keeps largest rank for every index, switches to dense representation if list is too long
+	void flush()
+	{
+		if (!is_sparse || buffer.empty())
+			return;
+
+		std::sort(buffer.begin(), buffer.end());
+		std::vector<uint32_t> merged;
+		merged.reserve(sparse.size() + buffer.size());
+		std::merge(sparse.begin(), sparse.end(), buffer.begin(), buffer.end(), std::back_inserter(merged));
+		buffer.clear();
+
+		//entries with the same index are adjacent and sorted by rank, keep the last one
+		size_t count = 0;
+		for (size_t x = 0; x < merged.size(); x++)
+		{
+			if (count > 0 && (merged[count - 1] >> 6) == (merged[x] >> 6))
+				merged[count - 1] = merged[x];
+			else merged[count++] = merged[x];
+		}
+		merged.resize(count);
+		sparse.swap(merged);
+
+		if (sparse.size() > sparse_limit())
+			to_dense();
+	}
+
+	void to_dense()
+	{
+		registers.assign(m, 0);
+		is_sparse = false;
+		for (auto& entry : sparse)
+			dense_update_entry(entry);
+		for (auto& entry : buffer)
+			dense_update_entry(entry);
+		std::vector<uint32_t>().swap(sparse);
+		std::vector<uint32_t>().swap(buffer);
+	}
+
+	void add_entry(const uint32_t& entry)
+	{
+		if (is_sparse)
+		{
+			buffer.push_back(entry);
+			if (buffer.size() >= std::max((size_t)min_buffer, sparse_limit() / 2))
+				flush();
+		}
+		else dense_update_entry(entry);
+	}
+public:
+	/// <param name="precision">Number of index bits, in range [4, 18], there are 2^precision registers</param>
+	/// <param name="seed">Seed of hash, only sketches with the same seed can be merged</param>
+	HyperLogLog(const int& precision = 14, const uint64_t& seed = 0x5BD1E995ull) : _seed(seed)
+	{
+		p = std::max(4, std::min(18, precision));
+		m = size_t(1) << p;
+	}
+
+	int GetPrecision() { return p; }
+	bool IsSparse() { return is_sparse; }
+
+	//number of bytes used by registers or sparse list
+	size_t MemoryUsage() { return registers.capacity() + (sparse.capacity() + buffer.capacity()) * sizeof(uint32_t); }
+
+	//adds item with already computed 64 bit hash, hash has to be uniformly distributed
+	void AddHash(const uint64_t& h)
+	{
+		if (is_sparse)
+			add_entry(sparse_entry(h));
+		else dense_update(h);
+	}
+
+	void Add(const T& item) { AddHash(hash_item(item)); }
+
+	void AddRange(const T* items, const size_t& count)
+	{
+		for (size_t x = 0; x < count; x++)
+			AddHash(hash_item(items[x]));
+	}
+
+	//returns estimated number of distinct items added
+	double Estimate()
+	{
+		if (is_sparse)
+		{
+			flush();
+			if (is_sparse) //linear counting on 2^25 virtual registers
+			{
+				const double virtual_m = (double)(uint64_t(1) << sparse_precision);
+				return virtual_m * std::log(virtual_m / (virtual_m - (double)sparse.size()));
+			}
+		}
+
+		double sum = 0;
+		size_t zeros = 0;
+		for (size_t x = 0; x < m; x++)
+		{
+			sum += std::ldexp(1.0, -registers[x]);
+			zeros += registers[x] == 0;
+		}
+
+		double alpha = m == 16 ? 0.673 : m == 32 ? 0.697 : m == 64 ? 0.709 : 0.7213 / (1 + 1.079 / m);
+		double estimate = alpha * (double)m * (double)m / sum;
+		if (estimate <= 2.5 * m && zeros > 0) //small range correction
+			estimate = (double)m * std::log((double)m / zeros);
+		return estimate;
+	}
+
+	/// <summary>
+	/// Merges other sketch into this one, result is the same as if all items of other were added to this sketch
+	/// Dense registers are merged with element wise max, which compilers vectorize
+	/// Returns false and does nothing if precisions or seeds differ
+	/// </summary>
+	bool Merge(const HyperLogLog& other)
+	{
+		if (other.p != p || other._seed != _seed)
+			return false;
+
+		if (other.is_sparse)
+		{
+			for (auto& entry : other.sparse)
+				add_entry(entry);
+			for (auto& entry : other.buffer)
+				add_entry(entry);
+			return true;
+		}
+
+		if (is_sparse)
+			to_dense();
+		uint8_t* mine = registers.data();
+		const uint8_t* theirs = other.registers.data();
+		for (size_t x = 0; x < m; x++)
+			mine[x] = std::max(mine[x], theirs[x]);
+		return true;
+	}
+
+	void Clear()
+	{
+		is_sparse = true;
+		std::vector<uint8_t>().swap(registers);
+		sparse.clear();
+		buffer.clear();
+	}
+};
@@ -1,4 +1,8 @@
 #pragma once
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <algorithm>
 #include "random.h"
 
 
@@ -51,3 +55,139 @@ public:
 		return pow(_base, _counter + 1) - _base;
 	}
 };
+
+
+/// <summary>
+/// Bank of 8 bit Morris counters with floating base, every counter can be incremented concurrently from many threads
+/// Counter value c stands for (base^c - 1)/(base - 1) events, c is incremented with propability base^-c
+/// Propabilities are precomputed into tables, so increment costs one random number and one compare, counters are updated with relaxed CAS
+/// Default base 1.08 counts up to about 4*10^9 events with relative standard error about sqrt((base-1)/2) = 20%
+/// </summary>
+template<class Engine = Xoshiro256StarStar>
+class ApproximateCounterBank
+{
+private:
+	static const int levels = 256;
+
+	std::unique_ptr<std::atomic<uint8_t>[]> counters;
+	size_t _size = 0;
+	double _base = 1.08;
+	uint64_t threshold[levels]; //counter c is incremented if 53 bit random number < threshold[c], threshold[c] = base^-c * 2^53
+	double log_fail[levels]; //log(1 - base^-c), used to draw geometric skips
+	double value[levels]; //approximated number of events for counter value c
+
+	static Engine& engine() { return BasicStaticRandom<Engine>::GetEngine(); }
+
+	//number of events needed for counter c to advance, geometric with propability base^-c
+	uint64_t draw_events(const uint8_t& c)
+	{
+		if (c == 0)
+			return 1;
+		double u = (double)((engine()() >> 11) + 1) * (1.0 / 9007199254740993.0);
+		double events = std::floor(std::log(u) / log_fail[c]) + 1;
+		return events >= 1.8e19 ? UINT64_MAX : (uint64_t)events;
+	}
+
+	//counter value after n more events starting from counter value c, needs one random number per advance of counter
+	uint8_t advance(uint8_t c, uint64_t n)
+	{
+		while (n > 0 && c < levels - 1)
+		{
+			uint64_t events = draw_events(c);
+			if (events > n)
+				break;
+			n -= events;
+			c++;
+		}
+		return c;
+	}
+public:
+	//creates bank of size counters set to 0, base has to be larger than 1, otherwise 1.08 is used
+	ApproximateCounterBank(const size_t& size, const double& base = 1.08) : counters(new std::atomic<uint8_t>[size]), _size(size)
+	{
+		if (base > 1)
+			_base = base;
+		for (size_t x = 0; x < size; x++)
+			counters[x].store(0, std::memory_order_relaxed);
+
+		for (int c = 0; c < levels; c++)
+		{
+			double p = std::pow(_base, -c);
+			threshold[c] = (uint64_t)(p * 9007199254740992.0);
+			log_fail[c] = c == 0 ? 0 : std::log1p(-p);
+			value[c] = (std::pow(_base, c) - 1) / (_base - 1);
+		}
+	}
+
+	size_t GetSize() { return _size; }
+	double GetBase() { return _base; }
+	uint8_t GetCounter(const size_t& index) { return counters[index].load(std::memory_order_relaxed); }
+
+	//counts one event on counter index, safe to call from many threads
+	void Increment(const size_t& index)
+	{
+		std::atomic<uint8_t>& counter = counters[index];
+		uint8_t c = counter.load(std::memory_order_relaxed);
+		//if other thread changed counter meanwhile, roll again with propability of new value
+		while (c < levels - 1 && (engine()() >> 11) < threshold[c])
+			if (counter.compare_exchange_weak(c, c + 1, std::memory_order_relaxed))
+				return;
+	}
+
+	//counts n events on counter index, safe to call from many threads
+	//needs one random number per level the counter advances, that is O(log_base(n)) instead of n
+	void Add(const size_t& index, const uint64_t& n)
+	{
+		std::atomic<uint8_t>& counter = counters[index];
+		uint8_t c = counter.load(std::memory_order_relaxed);
+		uint8_t next;
+		do
+		{
+			next = advance(c, n);
+			if (next == c)
+				return;
+		} while (!counter.compare_exchange_weak(c, next, std::memory_order_relaxed));
+	}
+
+	//returns approximated number of events counted by counter index
+	double Approximation(const size_t& index) { return value[GetCounter(index)]; }
+
+	/// <summary>
+	/// Merges other bank (for example shard filled by other thread) into this one, counter by counter
+	/// Smaller counter is added to larger as its approximated number of events, rounded randomly to keep sum unbiased
+	/// This bank can be incremented concurrently, other bank should not change during merge
+	/// Both banks need the same size and base, returns false and does nothing otherwise
+	/// </summary>
+	bool Merge(ApproximateCounterBank& other)
+	{
+		if (other._size != _size || other._base != _base)
+			return false;
+
+		for (size_t x = 0; x < _size; x++)
+		{
+			uint8_t theirs = other.GetCounter(x);
+			if (theirs == 0)
+				continue;
+
+			std::atomic<uint8_t>& counter = counters[x];
+			uint8_t c = counter.load(std::memory_order_relaxed);
+			uint8_t next;
+			do
+			{
+				double events = value[std::min(c, theirs)];
+				uint64_t whole = (uint64_t)events;
+				if (random_double(engine()) < events - whole)
+					whole++;
+				next = advance(std::max(c, theirs), whole);
+			} while (!counter.compare_exchange_weak(c, next, std::memory_order_relaxed));
+		}
+		return true;
+	}
+
+	//sets all counters to 0
+	void Clear()
+	{
+		for (size_t x = 0; x < _size; x++)
+			counters[x].store(0, std::memory_order_relaxed);
+	}
+};
@@ -1,21 +1,34 @@
 #pragma once
 #include <random>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "random_engines.h"
 
 // Class providing simple interface to generate pseudo random numbers
-class Random
+// Engine can be any engine from random_engines.h (or any 64 bit UniformRandomBitGenerator), Random uses xoshiro256**
+template<class Engine = Xoshiro256StarStar>
+class BasicRandom
 {
 private:
-	std::random_device rd;
-	std::mt19937 mt;
+	Engine engine;
+	MultiXoshiro256StarStar<> bulk; //used by Fill functions, seeded from engine
 public:
-	Random(): rd(), mt(std::mt19937(rd())){}
+	//seeds engine with non deterministic seed
+	BasicRandom(): engine(random_seed()), bulk(engine()){}
+	//seeds engine with given seed, same seed always generates the same numbers
+	explicit BasicRandom(const uint64_t& seed): engine(seed), bulk(engine()){}
+
+	void Seed(const uint64_t& seed) { engine.seed(seed); bulk.seed(engine()); }
+	Engine& GetEngine() { return engine; }
 
 	//Generates pseudo random number in range [left,right)
 	int Next(const int& left, const int& right)
 	{
 		if (right <= left)
 			return left-1;
-		return std::uniform_int_distribution<int>(left, right-1)(rd);
+		return (int)(left + (long long)random_bounded(engine, (uint64_t)((long long)right - left)));
 	}
 
 	//Generates 64 byte pseudo random number in range [left,right)
@@ -23,15 +36,15 @@ public:
 	{
 		if (right <= left)
 			return left - 1;
-		return std::uniform_int_distribution<long long>(left, right - 1)(rd);
+		return (long long)((uint64_t)left + random_bounded(engine, (uint64_t)right - (uint64_t)left));
 	}
 
-	//Generated pseudo random double in range [left, right]
+	//Generated pseudo random double in range [left, right)
 	double NextDouble(const double& left, const double& right)
 	{
 		if (right <= left)
 			return left;
-		return std::uniform_real_distribution<double>(left, right)(rd);
+		return left + (right - left) * random_double(engine);
 	}
 
 	//rolls a dice, given a chance, if roll was a success returns true, otherwise false
@@ -40,28 +53,101 @@ public:
 		if (chance >= 1) return true;
 		else if (chance <= 0) return false;
 
-		double random = std::uniform_real_distribution<double>(0.0, 1.0)(rd);
+		return random_double(engine) < chance;
+	}
 
-		if (random < chance) return true;
-		else return false;
+	//Fills out with count pseudo random numbers in range [left,right), does nothing if right <= left
+	void FillInts(int* out, const size_t& count, const int& left, const int& right)
+	{
+		if (right <= left)
+			return;
+		random_fill_bounded(bulk, engine, out, count, left, right);
 	}
+
+	//Fills out with count pseudo random doubles in range [0,1)
+	void FillDoubles(double* out, const size_t& count) { random_fill_double(bulk, out, count); }
+
+	//Fills out with count dice rolls, each roll succeeds with given chance
+	void FillRolls(bool* out, const size_t& count, const double& chance) { random_fill_bernoulli(bulk, out, count, chance); }
 };
 
+typedef BasicRandom<> Random;
+
 
 //Static Random generator, provides simple interface to generate pseudo random nubmers
-class StaticRandom
+//Every thread has its own engine, so it is safe to use it from many threads without locking
+//By default engines are seeded non deterministically, call Seed to get reproducible numbers
+template<class Engine = Xoshiro256StarStar>
+class BasicStaticRandom
 {
 private:
-	static std::random_device rd;
-	static std::mt19937 mt;
+	static std::atomic<bool>& seeded_mode() { static std::atomic<bool> mode(false); return mode; }
+	static std::atomic<uint64_t>& global_seed() { static std::atomic<uint64_t> seed(0); return seed; }
+	static std::atomic<uint64_t>& thread_counter() { static std::atomic<uint64_t> counter(0); return counter; }
+
+	//seed of engine of thread that uses StaticRandom for the first time
+	static uint64_t thread_seed()
+	{
+		if (!seeded_mode())
+			return random_seed();
+
+		SplitMix64 sm(global_seed() + thread_counter()++);
+		return sm();
+	}
 public:
+	//engine of calling thread
+	static Engine& GetEngine()
+	{
+		thread_local Engine engine(thread_seed());
+		return engine;
+	}
+
+	//multi lane engine of calling thread used by Fill functions, seeded from GetEngine
+	static MultiXoshiro256StarStar<>& GetBulkEngine()
+	{
+		thread_local MultiXoshiro256StarStar<> bulk(GetEngine()());
+		return bulk;
+	}
+
+	/// <summary>
+	/// Seeds engine of calling thread, threads that start using StaticRandom after this call derive their seeds from seed,
+	/// in order of first use. Single threaded programs get the same numbers on every run
+	/// </summary>
+	static void Seed(const uint64_t& seed)
+	{
+		global_seed() = seed;
+		thread_counter() = 1;
+		seeded_mode() = true;
+		MultiXoshiro256StarStar<>& bulk = GetBulkEngine(); //first use seeds bulk engine from GetEngine, so it is created before engine is reseeded
+		GetEngine().seed(seed);
+		bulk.seed(GetEngine()());
+	}
+
+	/// <summary>
+	/// Seeds engine of calling thread with index-th stream of given seed, streams of different indexes never overlap
+	/// Give every worker thread its own index to get reproducible and independent numbers in every thread
+	/// </summary>
+	static void SeedStream(const uint64_t& seed, const uint64_t& index)
+	{
+		MultiXoshiro256StarStar<>& bulk = GetBulkEngine();
+		GetEngine() = Engine::stream(seed, index);
+		bulk.seed(GetEngine()());
+	}
+
+	//Returns to non deterministic seeding, reseeds engine of calling thread
+	static void SeedRandomly()
+	{
+		seeded_mode() = false;
+		GetEngine().seed(random_seed());
+		GetBulkEngine().seed(GetEngine()());
+	}
 
 	//Generates pseudo random number in range [left,right)
 	static int Next(const int& left, const int& right)
 	{
 		if (right <= left)
 			return left-1;
-		return std::uniform_int_distribution<int>(left, right-1)(rd);
+		return (int)(left + (long long)random_bounded(GetEngine(), (uint64_t)((long long)right - left)));
 	}
 
 	//Generates 64 byte pseudo random number in range [left,right)
@@ -69,15 +155,15 @@ public:
 	{
 		if (right <= left)
 			return left - 1;
-		return std::uniform_int_distribution<long long>(left, right-1)(rd);
+		return (long long)((uint64_t)left + random_bounded(GetEngine(), (uint64_t)right - (uint64_t)left));
 	}
 
-	//Generated pseudo random double in range [left, right]
+	//Generated pseudo random double in range [left, right)
 	static double NextDouble(const double& left, const double& right)
 	{
 		if (right <= left)
 			return left;
-		return std::uniform_real_distribution<double>(left, right)(rd);
+		return left + (right - left) * random_double(GetEngine());
 	}
 
 	//rolls a dice, given a chance for success, if roll was a success returns true, otherwise false
@@ -86,12 +172,59 @@ public:
 		if (chance >= 1) return true;
 		else if (chance <= 0) return false;
 
-		double random = std::uniform_real_distribution<double>(0.0, 1.0)(rd);
+		return random_double(GetEngine()) < chance;
+	}
 
-		if (random < chance) return true;
-		else return false;
+	//Fills out with count pseudo random numbers in range [left,right), does nothing if right <= left
+	static void FillInts(int* out, const size_t& count, const int& left, const int& right)
+	{
+		if (right <= left)
+			return;
+		random_fill_bounded(GetBulkEngine(), GetEngine(), out, count, left, right);
 	}
+
+	//Fills out with count pseudo random doubles in range [0,1)
+	static void FillDoubles(double* out, const size_t& count) { random_fill_double(GetBulkEngine(), out, count); }
+
+	//Fills out with count dice rolls, each roll succeeds with given chance
+	static void FillRolls(bool* out, const size_t& count, const double& chance) { random_fill_bernoulli(GetBulkEngine(), out, count, chance); }
 };
 
-std::random_device StaticRandom::rd;
-std::mt19937 StaticRandom::mt = std::mt19937(rd());
+typedef BasicStaticRandom<> StaticRandom;
+
+
+/// <summary>
+/// Splits range [0, size) into blocks of block_size items and calls func(engine, begin, end) for every block from thread_count threads
+/// Every block gets its own Philox4x32 stream chosen by block index, so generated numbers depend only on seed and block_size,
+/// results are bit identical for any thread_count and any order in which threads pick blocks
+/// </summary>
+/// <param name="func">Called as func(Philox4x32&amp; engine, size_t begin, size_t end), has to write only into its own block</param>
+/// <param name="thread_count">Number of threads, 0 -> std::thread::hardware_concurrency()</param>
+template<class Func>
+void parallel_random_blocks(const size_t& size, const size_t& block_size, const uint64_t& seed, Func func, unsigned int thread_count = 0)
+{
+	if (size == 0 || block_size == 0)
+		return;
+	if (thread_count == 0)
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+	const size_t block_count = (size + block_size - 1) / block_size;
+	std::atomic<size_t> next_block(0);
+
+	auto worker = [&]() {
+		for (size_t block = next_block++; block < block_count; block = next_block++)
+		{
+			Philox4x32 engine(seed, block);
+			const size_t begin = block * block_size;
+			func(engine, begin, std::min(begin + block_size, size));
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned int x = 1; x < thread_count && x < block_count; x++)
+		threads.emplace_back(worker);
+	worker(); //calling thread works as well
+
+	for (auto& thread : threads)
+		thread.join();
+}
@@ -0,0 +1,534 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <algorithm>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// Multiplies two 64 bit numbers into 128 bit result
+/// </summary>
+/// <param name="high">Receives upper 64 bits of the result</param>
+/// <returns>Lower 64 bits of the result</returns>
+inline uint64_t random_mul_64(uint64_t a, uint64_t b, uint64_t& high)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 result = (unsigned __int128)a * b;
+	high = (uint64_t)(result >> 64);
+	return (uint64_t)result;
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return _umul128(a, b, &high);
+#else
+	//schoolbook multiplication on 32 bit halves
+	uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+	uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+	uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+	uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+	high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+	return (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+}
+
+inline uint64_t random_rotl(const uint64_t& x, const int& k) { return (x << k) | (x >> ((64 - k) & 63)); }
+inline uint64_t random_rotr(const uint64_t& x, const int& k) { return (x >> k) | (x << ((64 - k) & 63)); }
+
+//finalizer of SplitMix64, bijective mixing of 64 bit number, every input bit affects every output bit. Used to hash keys
+inline uint64_t random_mix64(uint64_t z)
+{
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+/// <summary>
+/// Returns non deterministic seed, calls std::random_device, so use it only to seed engines
+/// </summary>
+inline uint64_t random_seed()
+{
+	std::random_device rd;
+	return ((uint64_t)rd() << 32) ^ rd();
+}
+
+/// <summary>
+/// SplitMix64 generator by Sebastiano Vigna
+/// Very fast, passes BigCrush, but has only 64 bit state. Mainly used to seed other engines
+/// All engines here satisfy UniformRandomBitGenerator, so they can be used with std::shuffle and std distributions
+/// </summary>
+class SplitMix64
+{
+private:
+	uint64_t state = 0;
+public:
+	typedef uint64_t result_type;
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT64_MAX; }
+
+	SplitMix64() {}
+	SplitMix64(const uint64_t& seed) : state(seed) {}
+
+	void seed(const uint64_t& seed) { state = seed; }
+
+	uint64_t operator()()
+	{
+		return random_mix64(state += 0x9E3779B97F4A7C15ull);
+	}
+};
+
+/// <summary>
+/// xoshiro256** generator by David Blackman and Sebastiano Vigna
+/// 256 bit state, period 2^256-1, default engine of Random and StaticRandom
+/// </summary>
+class Xoshiro256StarStar
+{
+private:
+	uint64_t s[4];
+
+	//advances state as if operator() was called 2^k times, polynomial is given by jump table
+	void jump(const uint64_t* table)
+	{
+		uint64_t j[4] = { 0, 0, 0, 0 };
+		for (int x = 0; x < 4; x++)
+			for (int b = 0; b < 64; b++)
+			{
+				if (table[x] & (1ull << b))
+					for (int y = 0; y < 4; y++)
+						j[y] ^= s[y];
+				(*this)();
+			}
+
+		for (int y = 0; y < 4; y++)
+			s[y] = j[y];
+	}
+public:
+	typedef uint64_t result_type;
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT64_MAX; }
+
+	Xoshiro256StarStar() { seed(0); }
+	Xoshiro256StarStar(const uint64_t& seed) { this->seed(seed); }
+
+	//state is filled using SplitMix64, as recommended by authors, so it is never all zeroes
+	void seed(const uint64_t& seed)
+	{
+		SplitMix64 sm(seed);
+		for (int x = 0; x < 4; x++)
+			s[x] = sm();
+	}
+
+	uint64_t operator()()
+	{
+		const uint64_t result = random_rotl(s[1] * 5, 7) * 9;
+		const uint64_t t = s[1] << 17;
+
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = random_rotl(s[3], 45);
+
+		return result;
+	}
+
+	//advances state by 2^128 numbers, can be used to generate 2^128 non overlapping subsequences
+	void jump()
+	{
+		static const uint64_t table[4] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+		jump(table);
+	}
+
+	//advances state by 2^192 numbers, can be used to generate 2^64 starting points, from each jump() generates 2^64 subsequences
+	void long_jump()
+	{
+		static const uint64_t table[4] = { 0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull };
+		jump(table);
+	}
+
+	//returns 256 bit state of generator
+	void get_state(uint64_t* out) const
+	{
+		for (int x = 0; x < 4; x++)
+			out[x] = s[x];
+	}
+
+	//sets 256 bit state of generator, state must not be all zeroes
+	void set_state(const uint64_t* state)
+	{
+		for (int x = 0; x < 4; x++)
+			s[x] = state[x];
+	}
+
+	/// <summary>
+	/// Creates generator of index-th stream of given seed, streams are 2^128 numbers apart so they never overlap
+	/// Costs index jumps, so use it for streams per thread, for streams per work item use Philox4x32
+	/// </summary>
+	static Xoshiro256StarStar stream(const uint64_t& seed, const uint64_t& index)
+	{
+		Xoshiro256StarStar engine(seed);
+		for (uint64_t x = 0; x < index; x++)
+			engine.jump();
+		return engine;
+	}
+};
+
+/// <summary>
+/// PCG64 (XSL-RR 128/64) generator by Melissa O'Neill
+/// 128 bit LCG state with permuted output, different stream values give independent sequences
+/// </summary>
+class PCG64
+{
+private:
+	//128 bit numbers kept as two halves, so this works on compilers without __int128
+	uint64_t state_hi = 0, state_lo = 0;
+	uint64_t inc_hi = 0, inc_lo = 1;
+
+	static const uint64_t mult_hi = 0x2360ED051FC65DA4ull;
+	static const uint64_t mult_lo = 0x4385DF649FCCF645ull;
+
+	//state = state * mult + inc (mod 2^128)
+	void step()
+	{
+		uint64_t high;
+		uint64_t low = random_mul_64(state_lo, mult_lo, high);
+		high += state_hi * mult_lo + state_lo * mult_hi;
+
+		state_lo = low + inc_lo;
+		state_hi = high + inc_hi + (state_lo < low ? 1 : 0);
+	}
+public:
+	typedef uint64_t result_type;
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT64_MAX; }
+
+	PCG64() { seed(0); }
+	PCG64(const uint64_t& seed, const uint64_t& stream = 0) { this->seed(seed, stream); }
+
+	void seed(const uint64_t& seed, const uint64_t& stream = 0)
+	{
+		//increment has to be odd, stream selects one of 2^63 sequences
+		inc_hi = stream >> 63;
+		inc_lo = (stream << 1) | 1;
+
+		state_hi = 0;
+		state_lo = 0;
+		step();
+		state_lo += seed;
+		state_hi += (state_lo < seed ? 1 : 0);
+		step();
+	}
+
+	uint64_t operator()()
+	{
+		step();
+		return random_rotr(state_hi ^ state_lo, (int)(state_hi >> 58));
+	}
+
+	//creates generator of index-th stream of given seed, streams use different increments so they are independent sequences
+	static PCG64 stream(const uint64_t& seed, const uint64_t& index) { return PCG64(seed, index); }
+};
+
+/// <summary>
+/// Philox4x32-10 counter based generator by Salmon et al. (Random123)
+/// Output is a bijection of (key, counter), so any position of any stream can be computed directly without generating previous numbers
+/// Key is the seed, upper 64 bits of 128 bit counter select the stream, lower 64 bits are position in the stream
+/// Every block of counter gives 4 32 bit numbers, which are returned as 2 64 bit numbers
+/// </summary>
+class Philox4x32
+{
+private:
+	uint32_t key[2];
+	uint64_t stream_id = 0, position = 0; //counter of next block
+	uint64_t buffer[2];
+	int buffered = 0; //number of unused numbers in buffer
+
+	static void mulhilo(const uint32_t& a, const uint32_t& b, uint32_t& hi, uint32_t& lo)
+	{
+		const uint64_t product = (uint64_t)a * b;
+		hi = (uint32_t)(product >> 32);
+		lo = (uint32_t)product;
+	}
+public:
+	typedef uint64_t result_type;
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT64_MAX; }
+
+	Philox4x32() { seed(0); }
+	Philox4x32(const uint64_t& seed, const uint64_t& stream = 0) { this->seed(seed, stream); }
+
+	void seed(const uint64_t& seed, const uint64_t& stream = 0)
+	{
+		key[0] = (uint32_t)seed;
+		key[1] = (uint32_t)(seed >> 32);
+		stream_id = stream;
+		position = 0;
+		buffered = 0;
+	}
+
+	/// <summary>
+	/// Encrypts 128 bit counter with 64 bit key using 10 Philox rounds
+	/// </summary>
+	/// <param name="ctr">4 32 bit words of counter, receives result</param>
+	static void block(uint32_t* ctr, const uint32_t* key)
+	{
+		uint32_t k0 = key[0], k1 = key[1];
+		for (int round = 0; round < 10; round++)
+		{
+			uint32_t hi0, lo0, hi1, lo1;
+			mulhilo(0xD2511F53u, ctr[0], hi0, lo0);
+			mulhilo(0xCD9E8D57u, ctr[2], hi1, lo1);
+
+			const uint32_t c1 = ctr[1], c3 = ctr[3];
+			ctr[0] = hi1 ^ c1 ^ k0;
+			ctr[1] = lo1;
+			ctr[2] = hi0 ^ c3 ^ k1;
+			ctr[3] = lo0;
+
+			k0 += 0x9E3779B9u;
+			k1 += 0xBB67AE85u;
+		}
+	}
+
+	//returns number at given position of the stream, does not change the generator
+	uint64_t at(const uint64_t& index) const
+	{
+		uint32_t ctr[4] = { (uint32_t)(index >> 1), (uint32_t)(index >> 33), (uint32_t)stream_id, (uint32_t)(stream_id >> 32) };
+		block(ctr, key);
+		return (index & 1) ? ((uint64_t)ctr[3] << 32) | ctr[2] : ((uint64_t)ctr[1] << 32) | ctr[0];
+	}
+
+	uint64_t operator()()
+	{
+		if (buffered == 0)
+		{
+			uint32_t ctr[4] = { (uint32_t)position, (uint32_t)(position >> 32), (uint32_t)stream_id, (uint32_t)(stream_id >> 32) };
+			block(ctr, key);
+			position++;
+			buffer[0] = ((uint64_t)ctr[1] << 32) | ctr[0];
+			buffer[1] = ((uint64_t)ctr[3] << 32) | ctr[2];
+			buffered = 2;
+		}
+		return buffer[2 - buffered--];
+	}
+
+	//moves generator to given position of the stream in O(1), next call of operator() returns at(index)
+	void seek(const uint64_t& index)
+	{
+		position = index >> 1;
+		buffered = 0;
+		if (index & 1)
+			(*this)(); //drop first half of the block
+	}
+
+	//skips count numbers in O(1)
+	void discard(const uint64_t& count) { seek(tell() + count); }
+
+	//returns position of the next number in the stream
+	uint64_t tell() const { return position * 2 - buffered; }
+
+	//creates generator of index-th stream of given seed, streams never overlap
+	static Philox4x32 stream(const uint64_t& seed, const uint64_t& index) { return Philox4x32(seed, index); }
+};
+
+/// <summary>
+/// Generates unbiased random number in range [0, range) using Lemire's nearly divisionless method
+/// In most cases this costs single multiplication, division is done only when rejection may be needed
+/// Engine has to return full 64 bit numbers
+/// </summary>
+/// <param name="range">Size of the range, has to be greater than 0</param>
+template<class Engine>
+inline uint64_t random_bounded(Engine& engine, const uint64_t& range)
+{
+	uint64_t high;
+	uint64_t low = random_mul_64(engine(), range, high);
+	if (low < range)
+	{
+		const uint64_t threshold = (0 - range) % range; //2^64 mod range
+		while (low < threshold)
+			low = random_mul_64(engine(), range, high);
+	}
+	return high;
+}
+
+/// <summary>
+/// Generates random double in range [0, 1) with 53 bits of randomness
+/// </summary>
+template<class Engine>
+inline double random_double(Engine& engine)
+{
+	return (engine() >> 11) * (1.0 / 9007199254740992.0); //divide by 2^53
+}
+
+/// <summary>
+/// Multi lane xoshiro256** generator, runs lanes independent xoshiro256** generators side by side
+/// State is kept as structure of arrays, so loops over lanes are vectorized by the compiler (SSE2/AVX2)
+/// Used for bulk generation, where numbers are generated into buffers instead of one by one
+/// </summary>
+/// <typeparam name="lanes">Number of generators, 4 fills one AVX2 register, 8 gives more independent work per iteration</typeparam>
+template<int lanes = 8>
+class MultiXoshiro256StarStar
+{
+private:
+	uint64_t s0[lanes], s1[lanes], s2[lanes], s3[lanes];
+
+	//advances every lane once, writes outputs into out
+	static void step(uint64_t* a, uint64_t* b, uint64_t* c, uint64_t* d, uint64_t* out)
+	{
+		for (int l = 0; l < lanes; l++)
+		{
+			out[l] = random_rotl(b[l] * 5, 7) * 9;
+			const uint64_t t = b[l] << 17;
+
+			c[l] ^= a[l];
+			d[l] ^= b[l];
+			b[l] ^= c[l];
+			a[l] ^= d[l];
+			c[l] ^= t;
+			d[l] = random_rotl(d[l], 45);
+		}
+	}
+public:
+	typedef uint64_t result_type;
+	static const int lane_count = lanes;
+
+	MultiXoshiro256StarStar() { seed(0); }
+	MultiXoshiro256StarStar(const uint64_t& seed) { this->seed(seed); }
+
+	//lanes are consecutive jump() streams of xoshiro256** with given seed, so they never overlap
+	void seed(const uint64_t& seed)
+	{
+		Xoshiro256StarStar engine(seed);
+		uint64_t state[4];
+		for (int x = 0; x < lanes; x++)
+		{
+			engine.get_state(state);
+			s0[x] = state[0];
+			s1[x] = state[1];
+			s2[x] = state[2];
+			s3[x] = state[3];
+			engine.jump();
+		}
+	}
+
+	//generates one number per lane into out
+	void next(uint64_t* out) { fill(out, lanes); }
+
+	//fills out with count random numbers
+	void fill(uint64_t* out, const size_t& count)
+	{
+		//work on local copy of the state, so compiler knows that out does not alias it and vectorizes the loop over lanes
+		uint64_t a[lanes], b[lanes], c[lanes], d[lanes];
+		for (int l = 0; l < lanes; l++)
+		{
+			a[l] = s0[l];
+			b[l] = s1[l];
+			c[l] = s2[l];
+			d[l] = s3[l];
+		}
+
+		size_t x = 0;
+		for (; x + lanes <= count; x += lanes)
+			step(a, b, c, d, out + x);
+
+		if (x < count) //tail, rest of generated numbers is dropped
+		{
+			uint64_t tail[lanes];
+			step(a, b, c, d, tail);
+			for (size_t y = 0; y < count - x; y++)
+				out[x + y] = tail[y];
+		}
+
+		for (int l = 0; l < lanes; l++)
+		{
+			s0[l] = a[l];
+			s1[l] = b[l];
+			s2[l] = c[l];
+			s3[l] = d[l];
+		}
+	}
+};
+
+/// <summary>
+/// Size of blocks used by bulk generation functions, numbers are generated into stack buffer of this size, then converted
+/// </summary>
+const size_t random_bulk_block = 256;
+
+/// <summary>
+/// Fills out with unbiased random numbers in range [left, right), right - left has to fit into 32 bits
+/// Uses 32 bit multiply-shift on whole block, which vectorizes, rejection from Lemire's method is checked afterwards
+/// and only if any number in block could be biased (chance for that is range/2^32 per number)
+/// </summary>
+/// <param name="single">Scalar 64 bit engine used to regenerate rejected numbers</param>
+template<class BulkEngine, class Engine>
+void random_fill_bounded(BulkEngine& bulk, Engine& single, int* out, const size_t& count, const int& left, const int& right)
+{
+	const uint64_t range = (uint64_t)((long long)right - left);
+	const uint32_t threshold = (uint32_t)((0x100000000ull - range) % range); //2^32 mod range
+	uint64_t buffer[random_bulk_block];
+
+	for (size_t start = 0; start < count; start += random_bulk_block)
+	{
+		const size_t block = count - start < random_bulk_block ? count - start : random_bulk_block;
+		int* block_out = out + start;
+		bulk.fill(buffer, block);
+
+		bool rejected = false;
+		for (size_t x = 0; x < block; x++)
+		{
+			const uint64_t m = (buffer[x] >> 32) * range;
+			block_out[x] = (int)(left + (long long)(m >> 32));
+			rejected |= (uint32_t)m < threshold;
+		}
+
+		if (!rejected)
+			continue;
+
+		for (size_t x = 0; x < block; x++) //rare path, regenerate every biased number
+		{
+			uint64_t m = (buffer[x] >> 32) * range;
+			while ((uint32_t)m < threshold)
+				m = (single() >> 32) * range;
+			block_out[x] = (int)(left + (long long)(m >> 32));
+		}
+	}
+}
+
+/// <summary>
+/// Fills out with random doubles in range [0, 1)
+/// </summary>
+template<class BulkEngine>
+void random_fill_double(BulkEngine& bulk, double* out, const size_t& count)
+{
+	uint64_t buffer[random_bulk_block];
+	for (size_t start = 0; start < count; start += random_bulk_block)
+	{
+		const size_t block = count - start < random_bulk_block ? count - start : random_bulk_block;
+		bulk.fill(buffer, block);
+		for (size_t x = 0; x < block; x++)
+			out[start + x] = (buffer[x] >> 11) * (1.0 / 9007199254740992.0);
+	}
+}
+
+/// <summary>
+/// Fills out with results of Bernoulli trials, every trial succeeds with given chance
+/// Chance is converted into 64 bit threshold once, so every trial is single comparison
+/// </summary>
+template<class BulkEngine>
+void random_fill_bernoulli(BulkEngine& bulk, bool* out, const size_t& count, const double& chance)
+{
+	if (chance >= 1 || chance <= 0)
+	{
+		std::fill(out, out + count, chance >= 1);
+		return;
+	}
+
+	const uint64_t threshold = (uint64_t)(chance * 18446744073709551616.0); //chance * 2^64
+	uint64_t buffer[random_bulk_block];
+	for (size_t start = 0; start < count; start += random_bulk_block)
+	{
+		const size_t block = count - start < random_bulk_block ? count - start : random_bulk_block;
+		bulk.fill(buffer, block);
+		for (size_t x = 0; x < block; x++)
+			out[start + x] = buffer[x] < threshold;
+	}
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include "random.h"
+#include "Data Structures/Heap.h"
+
+/// <summary>
+/// Reservoir sampler (Li's Algorithm L), keeps uniform random sample of k items from stream of unknown length
+/// Uses O(k) memory, instead of rolling for every item it draws how many items to skip (geometric jumps),
+/// so it needs O(k(1 + log(n/k))) random numbers for stream of n items
+/// </summary>
+template<class T, class Engine = Xoshiro256StarStar>
+class ReservoirSampler
+{
+private:
+	std::vector<T> sample;
+	size_t _k = 0;
+	unsigned long long count = 0; //number of items seen
+	unsigned long long next = 0; //number of item (counting from 1) that will be put into sample next
+	double w = 0;
+	Engine engine;
+
+	//random double in range (0, 1), log of it is always finite
+	double uniform_open() { return (double)((engine() >> 11) + 1) * (1.0 / 9007199254740993.0); }
+
+	//draws next item to put into sample
+	void skip()
+	{
+		w *= std::exp(std::log(uniform_open()) / _k);
+		next += (unsigned long long)std::floor(std::log(uniform_open()) / std::log1p(-w)) + 1;
+	}
+public:
+	//sampler of k items, engine is seeded from engine of calling thread
+	ReservoirSampler(const size_t& k) : ReservoirSampler(k, StaticRandom::GetEngine()()) {}
+	ReservoirSampler(const size_t& k, const uint64_t& seed) : _k(k), engine(seed) { sample.reserve(k); }
+
+	/// <summary>
+	/// Adds item from the stream
+	/// </summary>
+	void Add(const T& item)
+	{
+		count++;
+		if (count <= _k)
+		{
+			sample.push_back(item);
+			if (count == _k)
+			{
+				w = 1;
+				next = _k;
+				skip();
+			}
+		}
+		else if (count == next)
+		{
+			sample[random_bounded(engine, _k)] = item;
+			skip();
+		}
+	}
+
+	/// <summary>
+	/// Adds array of items from the stream, items that are skipped are not even read
+	/// </summary>
+	void AddRange(const T* arr, const size_t& arr_size)
+	{
+		size_t x = 0;
+		for (; x < arr_size && count < _k; x++)
+			Add(arr[x]);
+
+		if (_k == 0)
+		{
+			count += arr_size;
+			return;
+		}
+		if (count < _k) //whole array went into sample
+			return;
+
+		const unsigned long long end = count + (arr_size - x); //count after whole array
+		while (next <= end)
+		{
+			sample[random_bounded(engine, _k)] = arr[next - count - 1 + x];
+			skip();
+		}
+		count = end;
+	}
+
+	//returns current sample, it has min(k, GetCount()) items in no particular order
+	const std::vector<T>& GetSample() { return sample; }
+	unsigned long long GetCount() { return count; }
+	size_t GetK() { return _k; }
+};
+
+/// <summary>
+/// Weighted reservoir sampler (Efraimidis-Spirakis A-ExpJ), keeps weighted random sample of k items without replacement from stream
+/// Every item gets key u^(1/weight), sample holds k items with the largest keys. Instead of drawing key for every item,
+/// it draws how much weight to skip before the next item enters the sample, so it needs O(k log(n/k)) random numbers
+/// Keys are kept as logarithms, so very small weights do not underflow
+/// </summary>
+template<class T, class Engine = Xoshiro256StarStar>
+class WeightedReservoirSampler
+{
+private:
+	struct Entry
+	{
+		double key; //log(u)/weight, sample keeps k largest keys
+		T item;
+	};
+	//min-heap on keys, top is the entry that is replaced next
+	struct EntryLess
+	{
+		bool operator()(const Entry& a, const Entry& b) const { return a.key < b.key; }
+	};
+
+	std::vector<Entry> reservoir;
+	size_t _k = 0;
+	double skip_weight = 0; //weight left to skip before next item enters reservoir
+	Engine engine;
+
+	double uniform_open() { return (double)((engine() >> 11) + 1) * (1.0 / 9007199254740993.0); }
+
+	//log of smallest key in reservoir
+	double threshold() { return reservoir[0].key; }
+
+	//draws weight to skip, X = log(u)/log(T) where T is the smallest key
+	void draw_skip() { skip_weight = std::log(uniform_open()) / threshold(); }
+
+	void replace_top(const T& item, const double& weight)
+	{
+		//new key is uniform in (T^w, 1) raised to 1/w, in log space: log(T^w + (1 - T^w)u)/w
+		const double t_w = std::exp(threshold() * weight);
+		const double key = std::log(t_w + (1 - t_w) * uniform_open()) / weight;
+		reservoir[0] = { key, item };
+		Heap<Entry, EntryLess>::heapify(reservoir.data(), reservoir.size(), 0);
+		draw_skip();
+	}
+public:
+	//sampler of k items, engine is seeded from engine of calling thread
+	WeightedReservoirSampler(const size_t& k) : WeightedReservoirSampler(k, StaticRandom::GetEngine()()) {}
+	WeightedReservoirSampler(const size_t& k, const uint64_t& seed) : _k(k), engine(seed) { reservoir.reserve(k); }
+
+	/// <summary>
+	/// Adds item with given weight from the stream, items with weight &lt;= 0 are never sampled
+	/// </summary>
+	void Add(const T& item, const double& weight)
+	{
+		if (weight <= 0 || _k == 0)
+			return;
+
+		if (reservoir.size() < _k)
+		{
+			reservoir.push_back({ std::log(uniform_open()) / weight, item });
+			if (reservoir.size() == _k)
+			{
+				Heap<Entry, EntryLess>::array_heapify(reservoir.data(), reservoir.size());
+				draw_skip();
+			}
+			return;
+		}
+
+		skip_weight -= weight;
+		if (skip_weight <= 0)
+			replace_top(item, weight);
+	}
+
+	/// <summary>
+	/// Adds array of items with their weights from the stream
+	/// </summary>
+	void AddRange(const T* items, const double* weights, const size_t& count)
+	{
+		for (size_t x = 0; x < count; x++)
+			Add(items[x], weights[x]);
+	}
+
+	//returns current sample, it has min(k, number of items with positive weight) items in no particular order
+	std::vector<T> GetSample()
+	{
+		std::vector<T> out;
+		out.reserve(reservoir.size());
+		for (auto& entry : reservoir)
+			out.push_back(entry.item);
+		return out;
+	}
+
+	size_t GetK() { return _k; }
+};
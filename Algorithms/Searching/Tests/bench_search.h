@@ -0,0 +1,302 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include "Utility/benchmark.h"
+#include "Algorithms/Searching/binary_search.h"
+#include "Algorithms/Searching/eytzinger.h"
+#include "Algorithms/Searching/batch_search.h"
+#include "Algorithms/Searching/interpolation_search.h"
+#include "Algorithms/Searching/adaptive_search.h"
+#include "Algorithms/Searching/linear_search.h"
+#include "Algorithms/Searching/learned_index.h"
+
+/// <summary>
+/// Sorted array of size ints (even numbers, so half of random queries miss) and random queries
+/// </summary>
+inline void make_search_bench_input(const size_t& size, const size_t& query_count, std::vector<int>& arr, std::vector<int>& queries, const uint64_t& seed)
+{
+	arr.resize(size);
+	for (size_t x = 0; x < size; x++)
+		arr[x] = (int)(2 * x);
+	std::mt19937_64 gen(seed);
+	std::uniform_int_distribution<long long> dist(0, 2 * (long long)size);
+	queries.resize(query_count);
+	for (auto& query : queries)
+		query = (int)dist(gen);
+}
+
+/// <summary>
+/// Compares lower bound searches on sorted arrays of ints from 16KB (L1 cache) up to max_bytes, every size is 4 times larger:
+/// std::lower_bound, branchless lower_bound, binary_search and EytzingerIndex (built once per size, not timed)
+/// Results are printed in millions of queries per second
+/// </summary>
+inline void bench_binary_search(const size_t& max_bytes = size_t(1) << 30, const size_t& query_count = size_t(1) << 20, const uint64_t& seed = 20240601)
+{
+	std::vector<int> arr, queries;
+	volatile size_t sink = 0;
+	for (size_t bytes = size_t(1) << 14; bytes <= max_bytes; bytes *= 4)
+	{
+		const size_t size = bytes / sizeof(int);
+		make_search_bench_input(size, query_count, arr, queries, seed);
+		std::cout << "Lower bound in " << size << " ints (" << (bytes >> 10) << " KB):\n";
+
+		print_throughput("std::lower_bound", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const int& query : queries)
+				sum += std::lower_bound(arr.begin(), arr.end(), query) - arr.begin();
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("lower_bound (branchless)", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const int& query : queries)
+				sum += lower_bound(arr.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("binary_search", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const int& query : queries)
+				sum += binary_search(arr.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+
+		EytzingerIndex<int> eytzinger(arr.data(), size);
+		print_throughput("EytzingerIndex::LowerBound", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const int& query : queries)
+				sum += eytzinger.LowerBound(query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+	}
+}
+
+/// <summary>
+/// Compares searching query_count random queries in sorted arrays of ints from 16KB up to max_bytes, every size is 16 times larger:
+/// repeated binary_search and lower_bound, batch_lower_bound, and for sorted queries repeated lower_bound and sorted_batch_lower_bound
+/// Results are printed in millions of queries per second
+/// </summary>
+inline void bench_batch_search(const size_t& max_bytes = size_t(1) << 30, const size_t& query_count = size_t(1) << 20, const uint64_t& seed = 20240601)
+{
+	std::vector<int> arr, queries;
+	std::vector<size_t> out(query_count);
+	volatile size_t sink = 0;
+	for (size_t bytes = size_t(1) << 14; bytes <= max_bytes; bytes *= 16)
+	{
+		const size_t size = bytes / sizeof(int);
+		make_search_bench_input(size, query_count, arr, queries, seed);
+		std::cout << "Batch of " << query_count << " queries in " << size << " ints (" << (bytes >> 10) << " KB):\n";
+
+		print_throughput("binary_search one by one", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const int& query : queries)
+				sum += binary_search(arr.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("lower_bound one by one", measure_throughput([&]() {
+			for (size_t x = 0; x < query_count; x++)
+				out[x] = lower_bound(arr.data(), size, queries[x]);
+			sink = out[0];
+		}, query_count, 3), "queries/s");
+		print_throughput("batch_lower_bound", measure_throughput([&]() {
+			batch_lower_bound(arr.data(), size, queries.data(), query_count, out.data());
+			sink = out[0];
+		}, query_count, 3), "queries/s");
+
+		std::sort(queries.begin(), queries.end());
+		print_throughput("lower_bound one by one (sorted)", measure_throughput([&]() {
+			for (size_t x = 0; x < query_count; x++)
+				out[x] = lower_bound(arr.data(), size, queries[x]);
+			sink = out[0];
+		}, query_count, 3), "queries/s");
+		print_throughput("sorted_batch_lower_bound", measure_throughput([&]() {
+			sorted_batch_lower_bound(arr.data(), size, queries.data(), query_count, out.data());
+			sink = out[0];
+		}, query_count, 3), "queries/s");
+	}
+}
+
+/// <summary>
+/// Compares binary_search, lower_bound, interpolation_lower_bound and AdaptiveSearch on size sorted 64 bit keys
+/// with uniform distribution and with skewed (exponential) distribution, where interpolation needs its bisection fallback
+/// Results are printed in millions of queries per second
+/// </summary>
+inline void bench_interpolation_search(const size_t& size = size_t(1) << 26, const size_t& query_count = size_t(1) << 20, const uint64_t& seed = 20240601)
+{
+	std::vector<long long> arr(size), queries(query_count);
+	volatile size_t sink = 0;
+	for (const bool skewed : { false, true })
+	{
+		std::mt19937_64 gen(seed);
+		std::uniform_real_distribution<double> dist(0, 1);
+		auto key = [&]() { return skewed ? (long long)std::exp(40 * dist(gen)) : (long long)(dist(gen) * 1e15); };
+		for (auto& item : arr)
+			item = key();
+		std::sort(arr.begin(), arr.end());
+		for (auto& query : queries)
+			query = key();
+
+		AdaptiveSearch<long long> adaptive(arr.data(), size);
+		std::cout << "Search in " << size << (skewed ? " skewed" : " uniform") << " keys (adaptive chooses "
+			<< (adaptive.GetStrategy() == SearchStrategy::Interpolation ? "interpolation" : "binary") << "):\n";
+		print_throughput("binary_search", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const long long& query : queries)
+				sum += binary_search(arr.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("lower_bound", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const long long& query : queries)
+				sum += lower_bound(arr.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("interpolation_lower_bound", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const long long& query : queries)
+				sum += interpolation_lower_bound(arr.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("AdaptiveSearch::LowerBound", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const long long& query : queries)
+				sum += adaptive.LowerBound(query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+	}
+}
+
+/// <summary>
+/// Compares search in short arrays of ints (found item is at random position, half of items are missing):
+/// scalar loop, std::find, linear_find, lower_bound in sorted copy, and linear_count and linear_contains_any with 4 keys
+/// Results are printed in millions of queries per second
+/// </summary>
+inline void bench_linear_search(const size_t& query_count = size_t(1) << 20, const uint64_t& seed = 20240601)
+{
+	volatile long long sink = 0;
+	for (const size_t size : { 16, 64, 256, 1024, 4096 })
+	{
+		std::vector<int> arr(size), sorted(size), queries(query_count);
+		std::mt19937_64 gen(seed);
+		for (size_t x = 0; x < size; x++)
+			arr[x] = (int)(2 * x);
+		std::shuffle(arr.begin(), arr.end(), gen);
+		std::copy(arr.begin(), arr.end(), sorted.begin());
+		std::sort(sorted.begin(), sorted.end());
+		std::uniform_int_distribution<int> dist(0, (int)(2 * size));
+		for (auto& query : queries)
+			query = dist(gen);
+
+		std::cout << "Search in " << size << " ints:\n";
+		print_throughput("scalar loop", measure_throughput([&]() {
+			long long sum = 0;
+			for (const int& query : queries)
+			{
+				long long found = -1;
+				for (size_t x = 0; x < size; x++)
+					if (arr[x] == query)
+					{
+						found = (long long)x;
+						break;
+					}
+				sum += found;
+			}
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("std::find", measure_throughput([&]() {
+			long long sum = 0;
+			for (const int& query : queries)
+				sum += std::find(arr.begin(), arr.end(), query) - arr.begin();
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("linear_find", measure_throughput([&]() {
+			long long sum = 0;
+			for (const int& query : queries)
+				sum += linear_find(arr.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("lower_bound (sorted)", measure_throughput([&]() {
+			long long sum = 0;
+			for (const int& query : queries)
+				sum += (long long)lower_bound(sorted.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("linear_count", measure_throughput([&]() {
+			long long sum = 0;
+			for (const int& query : queries)
+				sum += (long long)linear_count(arr.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("linear_contains_any (4 keys)", measure_throughput([&]() {
+			long long sum = 0;
+			for (size_t x = 0; x + 4 <= query_count; x += 4)
+				sum += linear_contains_any(arr.data(), size, queries.data() + x, 4);
+			sink = sum;
+		}, query_count / 4, 3), "queries/s");
+	}
+}
+
+/// <summary>
+/// Compares binary_search, lower_bound, EytzingerIndex and LearnedIndex with epsilon 16, 64 and 256 on sorted random 64 bit keys
+/// from 16MB up to max_bytes, every size is 4 times larger, with build time and memory of every index (array itself is not counted)
+/// Results are printed in millions of queries per second
+/// </summary>
+inline void bench_learned_index(const size_t& max_bytes = size_t(1) << 30, const size_t& query_count = size_t(1) << 20, const uint64_t& seed = 20240601)
+{
+	std::vector<long long> arr, queries(query_count);
+	volatile size_t sink = 0;
+	for (size_t bytes = size_t(16) << 20; bytes <= max_bytes; bytes *= 4)
+	{
+		const size_t size = bytes / sizeof(long long);
+		std::mt19937_64 gen(seed);
+		std::uniform_int_distribution<long long> dist(0, (long long)1 << 60);
+		arr.resize(size);
+		for (auto& item : arr)
+			item = dist(gen);
+		std::sort(arr.begin(), arr.end());
+		for (size_t x = 0; x < query_count; x++)
+			queries[x] = x % 2 ? dist(gen) : arr[gen() % size];
+		std::cout << "Lower bound in " << size << " random 64 bit keys (" << (bytes >> 20) << " MB):\n";
+
+		print_throughput("binary_search", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const long long& query : queries)
+				sum += binary_search(arr.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		print_throughput("lower_bound", measure_throughput([&]() {
+			size_t sum = 0;
+			for (const long long& query : queries)
+				sum += lower_bound(arr.data(), size, query);
+			sink = sum;
+		}, query_count, 3), "queries/s");
+		{
+			EytzingerIndex<long long> eytzinger(arr.data(), size);
+			print_throughput("EytzingerIndex::LowerBound", measure_throughput([&]() {
+				size_t sum = 0;
+				for (const long long& query : queries)
+					sum += eytzinger.LowerBound(query);
+				sink = sum;
+			}, query_count, 3), "queries/s");
+			std::cout << "  EytzingerIndex memory: " << (eytzinger.MemoryUsage() >> 10) << " KB\n";
+		}
+		for (const size_t epsilon : { 16, 64, 256 })
+		{
+			std::unique_ptr<LearnedIndex<long long>> learned;
+			print_throughput("LearnedIndex build (epsilon " + std::to_string(epsilon) + ")", measure_throughput([&]() {
+				learned.reset(new LearnedIndex<long long>(arr.data(), size, epsilon));
+			}, size, 1), "keys/s");
+			print_throughput("LearnedIndex::LowerBound (epsilon " + std::to_string(epsilon) + ")", measure_throughput([&]() {
+				size_t sum = 0;
+				for (const long long& query : queries)
+					sum += learned->LowerBound(query);
+				sink = sum;
+			}, query_count, 3), "queries/s");
+			std::cout << "  LearnedIndex memory: " << (learned->MemoryUsage() >> 10) << " KB, " << learned->GetSegmentCount() << " segments, "
+				<< learned->GetLevelCount() << " levels\n";
+		}
+	}
+}
@@ -0,0 +1,229 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include "Utility/testing.h"
+#include "Algorithms/Searching/binary_search.h"
+#include "Algorithms/Searching/eytzinger.h"
+#include "Algorithms/Searching/batch_search.h"
+#include "Algorithms/Searching/interpolation_search.h"
+#include "Algorithms/Searching/adaptive_search.h"
+#include "Algorithms/Searching/linear_search.h"
+#include "Algorithms/Searching/learned_index.h"
+#include "Utility/simd.h"
+
+/// <summary>
+/// Sorted input of search tests, every input pattern is sorted, so inputs have runs of duplicates and gaps
+/// Queries are present items, items between them and items outside of the range
+/// </summary>
+struct SearchInput
+{
+	std::vector<int> arr;
+	std::vector<int> queries;
+};
+
+inline SearchInput make_search_input(const size_t& size, const InputPattern& pattern, const uint64_t& seed)
+{
+	std::mt19937_64 gen(seed ^ (size * 0x9E3779B97F4A7C15ull) ^ (uint64_t)pattern);
+	SearchInput input;
+	input.arr.resize(size);
+	fill_pattern(input.arr.data(), size, pattern, gen);
+	for (auto& item : input.arr)
+		item *= 2; //odd queries are never present
+	std::sort(input.arr.begin(), input.arr.end());
+
+	input.queries = { -1, 0, 1, 2000001, 2000002 };
+	for (const int& item : input.arr)
+		if (input.queries.size() < 2000)
+		{
+			input.queries.push_back(item);
+			input.queries.push_back(item + 1);
+		}
+	std::uniform_int_distribution<int> dist(-1, 2000002);
+	for (int x = 0; x < 500; x++)
+		input.queries.push_back(dist(gen));
+	return input;
+}
+
+/// <summary>
+/// Differential test of searches in Algorithms/Searching against std::lower_bound and std::upper_bound,
+/// on ascending and descending arrays
+/// </summary>
+/// <param name="seed">Seed of generated inputs</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_search_differential(const uint64_t& seed = 20240601)
+{
+	TestReport report("search differential");
+	const std::vector<size_t> sizes = { 0, 1, 2, 3, 7, 8, 9, 100, 1000, 4097, 100000 };
+
+	for (const size_t& size : sizes)
+	{
+		for (const InputPattern& pattern : all_input_patterns)
+		{
+			SearchInput input = make_search_input(size, pattern, seed);
+			const std::vector<int>& arr = input.arr;
+			std::vector<int> desc(arr.rbegin(), arr.rend());
+			const std::string name = test_case_name("search", pattern, size, seed);
+			EytzingerIndex<int> eytzinger(arr.data(), size);
+			EytzingerIndex<int, std::greater<int>> eytzinger_desc(desc.data(), size);
+			AdaptiveSearch<int> adaptive(arr.data(), size), interpolation(arr.data(), size, SearchStrategy::Interpolation);
+			LearnedIndex<int> learned(arr.data(), size), learned_small(arr.data(), size, 2);
+			auto source = [&arr](const size_t& i, int& value) {
+				if (i >= arr.size())
+					return false;
+				value = arr[i];
+				return true;
+			};
+
+			std::mt19937_64 gen(seed + size);
+			for (const int& query : input.queries)
+			{
+				const size_t lower = std::lower_bound(arr.begin(), arr.end(), query) - arr.begin();
+				const size_t upper = std::upper_bound(arr.begin(), arr.end(), query) - arr.begin();
+				const size_t desc_lower = std::lower_bound(desc.begin(), desc.end(), query, std::greater<int>()) - desc.begin();
+				const bool found = lower < upper;
+				const std::string query_name = name + " query=" + std::to_string(query);
+
+				report.check(lower_bound(arr.data(), size, query) == lower, query_name + " lower_bound");
+				report.check(upper_bound(arr.data(), size, query) == upper, query_name + " upper_bound");
+				report.check(equal_range(arr.data(), size, query) == std::make_pair(lower, upper), query_name + " equal_range");
+				report.check(lower_bound(desc.data(), size, query, std::greater<int>()) == desc_lower, query_name + " lower_bound>");
+				report.check(binary_search(arr.data(), size, query) == found, query_name + " binary_search");
+				report.check(binary_search(desc.data(), size, query) == found, query_name + " binary_search desc");
+				report.check(eytzinger.LowerBound(query) == lower, query_name + " EytzingerIndex::LowerBound");
+				report.check(eytzinger.UpperBound(query) == upper, query_name + " EytzingerIndex::UpperBound");
+				report.check(eytzinger.Contains(query) == found, query_name + " EytzingerIndex::Contains");
+				report.check(eytzinger_desc.LowerBound(query) == desc_lower, query_name + " EytzingerIndex>::LowerBound");
+				report.check(interpolation_lower_bound(arr.data(), size, query) == lower, query_name + " interpolation_lower_bound");
+				report.check(interpolation_search(arr.data(), size, query) == found, query_name + " interpolation_search");
+				report.check(unbounded_lower_bound(source, query) == lower, query_name + " unbounded_lower_bound");
+				report.check(adaptive.LowerBound(query) == lower && interpolation.LowerBound(query) == lower, query_name + " AdaptiveSearch::LowerBound");
+				report.check(adaptive.Contains(query) == found, query_name + " AdaptiveSearch::Contains");
+				report.check(learned.LowerBound(query) == lower && learned_small.LowerBound(query) == lower, query_name + " LearnedIndex::LowerBound");
+				report.check(learned.Contains(query) == found && learned_small.Contains(query) == found, query_name + " LearnedIndex::Contains");
+				const size_t start = lower > 0 ? std::uniform_int_distribution<size_t>(0, lower)(gen) : 0;
+				report.check(exponential_lower_bound(arr.data(), size, start, query) == lower, query_name + " exponential_lower_bound start=" + std::to_string(start));
+				if (size > 0)
+					report.check(binary_search_recursive(arr.data(), 0, (long long)size - 1, query) == found, query_name + " binary_search_recursive");
+			}
+
+			std::vector<size_t> expected(input.queries.size()), out(input.queries.size());
+			for (size_t x = 0; x < input.queries.size(); x++)
+				expected[x] = std::lower_bound(arr.begin(), arr.end(), input.queries[x]) - arr.begin();
+			batch_lower_bound(arr.data(), size, input.queries.data(), input.queries.size(), out.data());
+			report.check(out == expected, name + " batch_lower_bound");
+
+			std::vector<int> sorted_queries = input.queries;
+			std::sort(sorted_queries.begin(), sorted_queries.end());
+			for (size_t x = 0; x < sorted_queries.size(); x++)
+				expected[x] = std::lower_bound(arr.begin(), arr.end(), sorted_queries[x]) - arr.begin();
+			sorted_batch_lower_bound(arr.data(), size, sorted_queries.data(), sorted_queries.size(), out.data());
+			report.check(out == expected, name + " sorted_batch_lower_bound");
+		}
+	}
+
+	//strategy follows distribution of keys
+	std::vector<double> uniform(size_t(1) << 21), skewed(size_t(1) << 21);
+	std::mt19937_64 gen(seed);
+	std::uniform_real_distribution<double> dist(0, 1);
+	for (size_t x = 0; x < uniform.size(); x++)
+	{
+		uniform[x] = dist(gen);
+		skewed[x] = std::exp(40 * uniform[x]);
+	}
+	std::sort(uniform.begin(), uniform.end());
+	std::sort(skewed.begin(), skewed.end());
+	report.check(choose_search_strategy(uniform.data(), uniform.size()) == SearchStrategy::Interpolation, "uniform keys use interpolation");
+	report.check(choose_search_strategy(skewed.data(), skewed.size()) == SearchStrategy::Binary, "skewed keys use binary search");
+	report.check(choose_search_strategy(uniform.data(), 1000) == SearchStrategy::Binary, "arrays in cache use binary search");
+	for (int x = 0; x < 1000; x++)
+	{
+		const double query = std::exp(40 * dist(gen));
+		const size_t expected = std::lower_bound(skewed.begin(), skewed.end(), query) - skewed.begin();
+		report.check(interpolation_lower_bound(skewed.data(), skewed.size(), query) == expected, "interpolation_lower_bound on skewed keys, query=" + std::to_string(query));
+	}
+
+	//learned index is exact on skewed keys and its model is a small fraction of the array for smooth keys
+	LearnedIndex<double> learned_uniform(uniform.data(), uniform.size()), learned_skewed(skewed.data(), skewed.size(), 16);
+	for (int x = 0; x < 1000; x++)
+	{
+		const double query = x % 2 ? std::exp(40 * dist(gen)) : skewed[gen() % skewed.size()];
+		const size_t expected = std::lower_bound(skewed.begin(), skewed.end(), query) - skewed.begin();
+		report.check(learned_skewed.LowerBound(query) == expected, "LearnedIndex::LowerBound on skewed keys, query=" + std::to_string(query));
+	}
+	report.check(learned_uniform.MemoryUsage() * 100 < uniform.size() * sizeof(double), "LearnedIndex model of uniform keys is under 1% of array");
+	report.check(learned_skewed.GetLevelCount() > 1 && learned_skewed.GetSegmentCount() > 1, "LearnedIndex over skewed keys has segments indexed by upper level");
+
+	return report.summary();
+}
+
+//checks linear_find, linear_count and linear_contains_any on arr against std::find, std::count and std::find_first_of
+template<class T>
+void check_linear_search(TestReport& report, const std::vector<T>& arr, const std::vector<T>& keys, const std::string& name)
+{
+	const size_t size = arr.size();
+	for (const T& key : keys)
+	{
+		const auto found = std::find(arr.begin(), arr.end(), key);
+		const long long expected = found == arr.end() ? -1 : (long long)(found - arr.begin());
+		const std::string key_name = name + " key=" + std::to_string(key);
+		report.check(linear_find(arr.data(), size, key) == expected, key_name + " linear_find");
+		report.check(linear_search(arr.data(), size, key) == (expected >= 0), key_name + " linear_search");
+		report.check(linear_count(arr.data(), size, key) == (size_t)std::count(arr.begin(), arr.end(), key), key_name + " linear_count");
+	}
+	for (const size_t& key_count : { (size_t)0, (size_t)1, (size_t)3, (size_t)16, (size_t)17, keys.size() })
+	{
+		const size_t count = std::min(key_count, keys.size());
+		const auto found = std::find_first_of(arr.begin(), arr.end(), keys.begin(), keys.begin() + count);
+		const long long expected = found == arr.end() ? -1 : (long long)(found - arr.begin());
+		report.check(linear_contains_any(arr.data(), size, keys.data(), count) == expected, name + " linear_contains_any keys=" + std::to_string(count));
+	}
+}
+
+/// <summary>
+/// Differential test of vectorized linear search against std::find, std::count and std::find_first_of
+/// Every instruction set supported by cpu is tested for 32 and 64 bit integers, float and double and sizes around vector widths
+/// </summary>
+/// <param name="seed">Seed of generated inputs</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_linear_search_differential(const uint64_t& seed = 20240601)
+{
+	TestReport report("linear search differential");
+	const std::vector<size_t> sizes = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000 };
+	const SimdLevel detected = simd_detect_level();
+	const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE41, SimdLevel::AVX2 };
+
+	for (const SimdLevel& level : levels)
+	{
+		if (level > detected)
+			continue;
+		simd_limit_level(level);
+		for (const size_t& size : sizes)
+		{
+			std::mt19937_64 gen(seed ^ (size * 0x9E3779B97F4A7C15ull));
+			std::uniform_int_distribution<int> dist(-50, 50);
+			std::vector<int> ints(size);
+			for (auto& item : ints)
+				item = dist(gen);
+			std::vector<int> keys(40);
+			for (auto& key : keys)
+				key = dist(gen);
+			keys[0] = size > 0 ? ints[size - 1] : 0; //found only in the last element or tail
+			keys[1] = 1000; //never found
+
+			const std::string name = "level " + std::to_string((int)level) + " size=" + std::to_string(size) + " seed=" + std::to_string(seed);
+			check_linear_search(report, ints, keys, name + " int");
+			check_linear_search(report, std::vector<unsigned int>(ints.begin(), ints.end()), std::vector<unsigned int>(keys.begin(), keys.end()), name + " unsigned int");
+			check_linear_search(report, std::vector<long long>(ints.begin(), ints.end()), std::vector<long long>(keys.begin(), keys.end()), name + " long long");
+			check_linear_search(report, std::vector<float>(ints.begin(), ints.end()), std::vector<float>(keys.begin(), keys.end()), name + " float");
+			check_linear_search(report, std::vector<double>(ints.begin(), ints.end()), std::vector<double>(keys.begin(), keys.end()), name + " double");
+			check_linear_search(report, std::vector<short>(ints.begin(), ints.end()), std::vector<short>(keys.begin(), keys.end()), name + " short");
+		}
+	}
+	simd_limit_level(detected);
+
+	return report.summary();
+}
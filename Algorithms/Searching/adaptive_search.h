@@ -0,0 +1,86 @@
+#pragma once
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+#include "Algorithms/Searching/binary_search.h"
+#include "Algorithms/Searching/interpolation_search.h"
+
+/// <summary>
+/// Strategies of search in sorted array chosen by AdaptiveSearch
+/// </summary>
+enum class SearchStrategy { Binary, Interpolation };
+
+template<class T>
+SearchStrategy choose_search_strategy_impl(const T*, const size_t&, const size_t&, std::false_type)
+{
+	return SearchStrategy::Binary;
+}
+
+template<class T>
+SearchStrategy choose_search_strategy_impl(const T* arr, const size_t& size, const size_t& samples, std::true_type)
+{
+	//in cache binary search is faster, interpolation pays off only when its fewer probes save cache misses
+	const size_t min_bytes = size_t(8) << 20;
+	if (size * sizeof(T) < min_bytes || samples < 2 || !(arr[0] < arr[size - 1]))
+		return SearchStrategy::Binary;
+
+	//distance between real position of sampled item and position predicted by line through the ends of array
+	const double first = (double)arr[0], range = (double)arr[size - 1] - first;
+	double max_error = 0;
+	for (size_t s = 1; s < samples; s++)
+	{
+		const size_t i = (size_t)((double)(size - 1) * s / samples);
+		const double predicted = ((double)arr[i] - first) / range * (double)(size - 1);
+		max_error = std::max(max_error, std::abs(predicted - (double)i) / (double)size);
+	}
+	return max_error <= 0.05 ? SearchStrategy::Interpolation : SearchStrategy::Binary;
+}
+
+/// <summary>
+/// Chooses strategy for searching in ascending array from samples evenly spaced across it
+/// Interpolation is chosen for arrays larger than 8MB of numbers whose sampled positions lie close to the line through the ends of array
+/// (nearly uniform keys), binary search for everything else (skewed keys, arrays that fit in cache, types that are not numbers)
+/// </summary>
+template<class T>
+SearchStrategy choose_search_strategy(const T* arr, const size_t& size, const size_t& samples = 64)
+{
+	if (arr == nullptr && size > 0) throw std::invalid_argument("Array cannot be nullptr");
+	return choose_search_strategy_impl(arr, size, samples, std::integral_constant<bool, std::is_arithmetic<T>::value>());
+}
+
+/// <summary>
+/// Search in ascending array that picks the strategy once from samples of the array (see choose_search_strategy)
+/// Array is not copied, it has to live and stay unchanged as long as AdaptiveSearch is used
+/// </summary>
+template<class T>
+class AdaptiveSearch
+{
+private:
+	const T* _arr = nullptr;
+	size_t _size = 0;
+	SearchStrategy strategy = SearchStrategy::Binary;
+
+	size_t interpolation(const T& item, std::true_type) const { return interpolation_lower_bound(_arr, _size, item); }
+	size_t interpolation(const T& item, std::false_type) const { return lower_bound(_arr, _size, item); }
+public:
+	AdaptiveSearch(const T* arr, const size_t& size) : _arr(arr), _size(size), strategy(choose_search_strategy(arr, size)) {}
+	AdaptiveSearch(const T* arr, const size_t& size, const SearchStrategy& forced) : _arr(arr), _size(size), strategy(forced) {}
+
+	SearchStrategy GetStrategy() const { return strategy; }
+
+	//returns index of the first element that is not less than item, size if there is none
+	size_t LowerBound(const T& item) const
+	{
+		if (strategy == SearchStrategy::Interpolation)
+			return interpolation(item, std::integral_constant<bool, std::is_arithmetic<T>::value>());
+		return lower_bound(_arr, _size, item);
+	}
+
+	//returns true if item is in the array
+	bool Contains(const T& item) const
+	{
+		const size_t i = LowerBound(item);
+		return i < _size && !(item < _arr[i]);
+	}
+};
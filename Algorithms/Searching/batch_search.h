@@ -0,0 +1,68 @@
+#pragma once
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include "Utility/simd.h"
+#include "Algorithms/Searching/binary_search.h"
+
+/// <summary>
+/// Lower bounds of many queries in sorted array, out[x] is position of the first item of arr that is not before queries[x]
+/// Queries are searched in groups of 32 in lockstep. Branchless halving takes the same number of steps
+/// for every query, so after every step of one query its next probe is prefetched and loaded while the other queries of the group
+/// make their steps. Instead of one dependent cache miss after another, group has many misses in flight
+/// </summary>
+/// <param name="comp">Order of the array, std::less for ascending, std::greater for descending arrays</param>
+template<class T, class Comparator = std::less<T>>
+void batch_lower_bound(const T* arr, const size_t& size, const T* queries, const size_t& query_count, size_t* out, Comparator comp = Comparator())
+{
+	if ((arr == nullptr && size > 0) || ((queries == nullptr || out == nullptr) && query_count > 0)) throw std::invalid_argument("Array cannot be nullptr");
+	if (size == 0)
+	{
+		std::fill(out, out + query_count, 0);
+		return;
+	}
+
+	const size_t group = 32;
+	const T* bases[group];
+	for (size_t first = 0; first < query_count; first += group)
+	{
+		const size_t count = std::min(group, query_count - first);
+		const T* items = queries + first;
+		for (size_t j = 0; j < count; j++)
+			bases[j] = arr;
+
+		size_t n = size;
+		while (n > 1)
+		{
+			const size_t half = n / 2;
+			n -= half;
+			for (size_t j = 0; j < count; j++)
+			{
+				bases[j] = comp(bases[j][half], items[j]) ? bases[j] + half : bases[j];
+				simd_prefetch(bases[j] + n / 2);
+			}
+		}
+		for (size_t j = 0; j < count; j++)
+			out[first + j] = (size_t)(bases[j] - arr) + comp(*bases[j], items[j]);
+	}
+}
+
+/// <summary>
+/// Lower bounds of sorted queries in sorted array, out[x] is position of the first item of arr that is not before queries[x]
+/// Every search starts where the previous one ended and gallops forward (exponential_lower_bound), as in merge of two sorted arrays,
+/// so the whole batch takes O(q log(n/q)) comparisons and walks array only forward
+/// </summary>
+/// <param name="queries">Queries sorted by comp</param>
+template<class T, class Comparator = std::less<T>>
+void sorted_batch_lower_bound(const T* arr, const size_t& size, const T* queries, const size_t& query_count, size_t* out, Comparator comp = Comparator())
+{
+	if ((arr == nullptr && size > 0) || ((queries == nullptr || out == nullptr) && query_count > 0)) throw std::invalid_argument("Array cannot be nullptr");
+
+	size_t position = 0;
+	for (size_t x = 0; x < query_count; x++)
+	{
+		if (x > 0 && comp(queries[x], queries[x - 1])) throw std::invalid_argument("Queries have to be sorted");
+		position = exponential_lower_bound(arr, size, position, queries[x], comp);
+		out[x] = position;
+	}
+}
@@ -1,61 +1,154 @@
 #pragma once
-#include <math.h>
+#include <functional>
+#include <utility>
+#include "Utility/simd.h"
 
-template<class T>
-inline bool binary_search_desc(T* arr, const size_t& size, const T& item)
+/*
+* Branchless lower bound, returns index of the first element of sorted range that is not before item (size if there is none)
+* Every step halves the range with conditional move instead of branch, so there are no mispredictions and the number
+* of steps depends only on size. Both possible midpoints of the next step are prefetched, so the cache miss
+* of the next step overlaps with the current one, which matters once the array does not fit into cache
+* comp - order of the array, std::less for ascending, std::greater for descending arrays
+*/
+template<class T, class Comparator = std::less<T>>
+inline size_t lower_bound(const T* arr, const size_t& size, const T& item, Comparator comp = Comparator())
 {
-	int p = 0, q = 0, r = size; // begin, middle, end of actual subarray
-	q = floor(size / 2); // middle of the array
+	if (size == 0)
+		return 0;
 
-	while (p <= r)
+	const T* base = arr;
+	size_t n = size;
+	while (n > 1)
 	{
-		if (item == arr[q])
-			return true;
-		if (item < arr[q]) // if the item is on the left of the array
-			r = q -1;
-		else
-			p = q +1;
-		q = p + (r-p)/2;
+		const size_t half = n / 2;
+		n -= half;
+		simd_prefetch(base + n / 2);
+		simd_prefetch(base + half + n / 2);
+		base = comp(base[half], item) ? base + half : base;
 	}
+	return (size_t)(base - arr) + comp(*base, item);
+}
 
-	return false;
+/*
+* Branchless upper bound, returns index of the first element of sorted range that is after item (size if there is none)
+* Same as lower_bound, see it for details
+*/
+template<class T, class Comparator = std::less<T>>
+inline size_t upper_bound(const T* arr, const size_t& size, const T& item, Comparator comp = Comparator())
+{
+	if (size == 0)
+		return 0;
+
+	const T* base = arr;
+	size_t n = size;
+	while (n > 1)
+	{
+		const size_t half = n / 2;
+		n -= half;
+		simd_prefetch(base + n / 2);
+		simd_prefetch(base + half + n / 2);
+		base = comp(item, base[half]) ? base : base + half;
+	}
+	return (size_t)(base - arr) + !comp(item, *base);
 }
 
-template<class T>
-inline bool binary_search_asc(T* arr, const size_t& size, const T& item)
+/*
+* Returns range [first, second) of elements equal to item in sorted array, empty range at position of item if there is none
+*/
+template<class T, class Comparator = std::less<T>>
+inline std::pair<size_t, size_t> equal_range(const T* arr, const size_t& size, const T& item, Comparator comp = Comparator())
 {
-	int p = 0, q = 0, r = size; // begin, middle, end of actual subarray
-	q = floor(size / 2); // middle of the array
+	return std::make_pair(lower_bound(arr, size, item, comp), upper_bound(arr, size, item, comp));
+}
 
-	while (p <= r)
+/*
+* Exponential (galloping) lower bound for item that is known to be at position start or after it
+* Checks positions start+1, start+2, start+4, ... until it passes item, then searches only the last gap,
+* so it takes O(log d) comparisons where d is distance from start to result, which is good for nearby items
+*/
+template<class T, class Comparator = std::less<T>>
+inline size_t exponential_lower_bound(const T* arr, const size_t& size, const size_t& start, const T& item, Comparator comp = Comparator())
+{
+	if (start >= size || !comp(arr[start], item))
+		return start;
+
+	size_t low = start; //arr[low] is before item
+	size_t step = 1;
+	size_t high = start + 1;
+	while (high < size && comp(arr[high], item))
 	{
-		if (item == arr[q])
-			return true;
-		if (item > arr[q]) // if the item is on the left of the array
-			r = q - 1;
-		else
-			p = q + 1;
-		q = p + (r - p) / 2;
+		low = high;
+		step *= 2;
+		high = low + step;
 	}
+	if (high > size)
+		high = size;
+	return low + 1 + lower_bound(arr + low + 1, high - low - 1, item, comp);
+}
 
-	return false;
+/*
+* Lower bound in sorted sequence of unknown length, such as stream or lazily generated sequence
+* source(i, value) stores ith item in value and returns true, or returns false if sequence has less than i+1 items
+* Gallops over positions 0, 1, 3, 7, ... until it passes item or end, then bisects the last gap,
+* so it reads O(log p) items where p is the result and never needs the length
+* Returns position of the first item that is not before item, or length of sequence if there is none
+*/
+template<class T, class Source, class Comparator = std::less<T>>
+inline size_t unbounded_lower_bound(Source source, const T& item, Comparator comp = Comparator())
+{
+	T value;
+	//position is before item if it exists and its value is before item, missing positions are after every item
+	auto before = [&](const size_t& i) { return source(i, value) && comp(value, item); };
+
+	if (!before(0))
+		return 0;
+	size_t low = 0; //position before item
+	size_t step = 1;
+	size_t high = 1;
+	while (before(high))
+	{
+		low = high;
+		step *= 2;
+		high = low + step;
+	}
+	//result is in (low, high]
+	while (high - low > 1)
+	{
+		const size_t middle = low + (high - low) / 2;
+		if (before(middle))
+			low = middle;
+		else high = middle;
+	}
+	return high;
+}
+
+template<class T>
+inline bool binary_search_asc(const T* arr, const size_t& size, const T& item)
+{
+	const size_t i = lower_bound(arr, size, item);
+	return i < size && !(item < arr[i]);
+}
+
+template<class T>
+inline bool binary_search_desc(const T* arr, const size_t& size, const T& item)
+{
+	const size_t i = lower_bound(arr, size, item, std::greater<T>());
+	return i < size && !(arr[i] < item);
 }
 
 
 /*
 * In binary search algorithm initial array has to be sorted
 * This implementation evokes proper function for ascending and descdening arrays
+* Order is found from the first and the last element, so equal neighbours cannot mislead it
 */
 template<class T>
-inline bool binary_search(T* arr, const size_t& size, const T& item)
+inline bool binary_search(const T* arr, const size_t& size, const T& item)
 {
-	//1 item or invalid array properties cases
-	if (size == 1 && arr[0] == item)
-		return true;
-	else if (size < 1)
+	if (size < 1)
 		return false;
 
-	if (arr[0] < arr[1])
+	if (arr[size - 1] < arr[0])
 		return binary_search_desc(arr, size, item);
 	else
 		return binary_search_asc(arr, size, item);
@@ -69,19 +162,16 @@ inline bool binary_search(T* arr, const size_t& size, const T& item)
 * No implementation for descending functions is provided
 */
 template<class T>
-inline bool binary_search_recursive(T* arr, int p, int r, const T& item)
+inline bool binary_search_recursive(const T* arr, long long p, long long r, const T& item)
 {
-	int q = floor((p+r) / 2); // middle of the array
-
-	while (p <= r)
-	{
-		if (item == arr[q])
-			return true;
-		if (item < arr[q]) // if the item is on the left of the array
-			return binary_search_recursive(arr, p, r = q -1, item);
-		else
-			return binary_search_recursive(arr, p = q +1, r, item);
-	}
+	if (p > r)
+		return false;
 
-	return false;
-}
\ No newline at end of file
+	long long q = p + (r - p) / 2; // middle of the array
+	if (item == arr[q])
+		return true;
+	if (item < arr[q]) // if the item is on the left of the array
+		return binary_search_recursive(arr, p, q - 1, item);
+	else
+		return binary_search_recursive(arr, q + 1, r, item);
+}
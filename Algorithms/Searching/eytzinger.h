@@ -0,0 +1,128 @@
+#pragma once
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "Utility/simd.h"
+
+/// <summary>
+/// Static search index, copy of sorted array in Eytzinger (BFS) layout: node k has children 2k and 2k+1, as in heap
+/// Binary search over sorted array touches a new cache line on every step far from the middle, while in this layout
+/// the first levels share few cache lines and all 16 descendants of node 4 levels below (for 4 byte items) are in one cache line,
+/// so that line is prefetched 4 steps before it is needed and memory latency of searches overlaps
+/// Search is branchless, positions returned are positions in original sorted array
+/// Index uses the same memory as the array, it is built in O(n) and cannot be modified
+/// </summary>
+/// <typeparam name="Comparator">Order of the array, std::less for ascending, std::greater for descending arrays</typeparam>
+template<class T, class Comparator = std::less<T>>
+class EytzingerIndex
+{
+private:
+	static const size_t cache_line = 64;
+	//node k * prefetch_stride is the first of descendants of k that fill one cache line
+	static const size_t prefetch_stride = sizeof(T) < cache_line ? cache_line / sizeof(T) : 1;
+
+	std::vector<T> storage; //nodes, with padding that aligns node 0 to cache line
+	T* tree = nullptr; //tree[1..n] are nodes, tree[1] is root
+	size_t n = 0;
+	int height = 0; //number of levels
+	Comparator comp;
+
+	//fills nodes of subtree of k in order from sorted array, returns index of the next item of sorted array
+	size_t build(const T* sorted, size_t i, const size_t& k)
+	{
+		if (k > n)
+			return i;
+		i = build(sorted, i, 2 * k);
+		tree[k] = sorted[i++];
+		return build(sorted, i, 2 * k + 1);
+	}
+
+	/// <summary>
+	/// Position of node k in sorted array. In perfect tree of the same height in order rank of node k at depth d is
+	/// (2(k - 2^d) + 1) 2^(height-1-d) - 1, missing leaves of the last level have even ranks from 2 * present_leaves,
+	/// so rank is reduced by the number of missing leaves before node
+	/// </summary>
+	size_t position(const size_t& k) const
+	{
+		const int depth = 63 - bit_leading_zeros(k);
+		const size_t perfect = ((2 * (k - (size_t(1) << depth)) + 1) << (height - 1 - depth)) - 1;
+		const size_t present_leaves = n - (size_t(1) << (height - 1)) + 1;
+		const size_t missing_before = (perfect + 1) / 2 > present_leaves ? (perfect + 1) / 2 - present_leaves : 0;
+		return perfect - missing_before;
+	}
+
+	//node where search ended is the last node where search went left, it is found by removing trailing right turns and one left turn
+	size_t finish(const size_t& k) const
+	{
+		const size_t node = (size_t)((uint64_t)k >> (bit_trailing_zeros(~(uint64_t)k) + 1));
+		return node == 0 ? n : position(node);
+	}
+public:
+	/// <param name="sorted">Array sorted by comparator, it is copied and can be deleted after creation of index</param>
+	EytzingerIndex(const T* sorted, const size_t& size, Comparator comparator = Comparator()) : n(size), comp(comparator)
+	{
+		if (sorted == nullptr && size > 0) throw std::invalid_argument("Array cannot be nullptr");
+
+		const size_t padding = cache_line / sizeof(T) + 1;
+		storage.resize(n + 1 + padding);
+		const uintptr_t address = (uintptr_t)storage.data();
+		const uintptr_t misalignment = address % cache_line;
+		tree = storage.data() + (misalignment == 0 || misalignment % sizeof(T) != 0 ? 0 : (cache_line - misalignment) / sizeof(T));
+		height = n == 0 ? 0 : 64 - bit_leading_zeros(n);
+		build(sorted, 0, 1);
+	}
+
+	//index owns pointer into its storage, it can be moved but not copied
+	EytzingerIndex(const EytzingerIndex&) = delete;
+	EytzingerIndex& operator=(const EytzingerIndex&) = delete;
+	EytzingerIndex(EytzingerIndex&&) = default;
+	EytzingerIndex& operator=(EytzingerIndex&&) = default;
+
+	size_t GetSize() const { return n; }
+
+	//number of bytes used by nodes
+	size_t MemoryUsage() const { return storage.capacity() * sizeof(T); }
+
+	/// <summary>
+	/// Returns position of the first item in sorted array that is not before item, GetSize() if there is none
+	/// </summary>
+	size_t LowerBound(const T& item) const
+	{
+		size_t k = 1;
+		while (k <= n)
+		{
+			//prefetching past the last node is harmless, prefetch never faults
+			simd_prefetch(tree + k * prefetch_stride);
+			k = 2 * k + comp(tree[k], item);
+		}
+		return finish(k);
+	}
+
+	/// <summary>
+	/// Returns position of the first item in sorted array that is after item, GetSize() if there is none
+	/// </summary>
+	size_t UpperBound(const T& item) const
+	{
+		size_t k = 1;
+		while (k <= n)
+		{
+			simd_prefetch(tree + k * prefetch_stride);
+			k = 2 * k + !comp(item, tree[k]);
+		}
+		return finish(k);
+	}
+
+	//returns true if item is in the array
+	bool Contains(const T& item) const
+	{
+		size_t k = 1;
+		while (k <= n)
+		{
+			simd_prefetch(tree + k * prefetch_stride);
+			k = 2 * k + comp(tree[k], item);
+		}
+		k >>= bit_trailing_zeros(~(uint64_t)k) + 1;
+		return k != 0 && !comp(item, tree[k]);
+	}
+};
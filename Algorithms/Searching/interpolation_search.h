@@ -0,0 +1,76 @@
+#pragma once
+#include <type_traits>
+#include "Utility/simd.h"
+#include "Algorithms/Searching/binary_search.h"
+
+/*
+* Interpolation lower bound in ascending array of numbers, returns index of the first element that is not less than item
+* Probe is placed where item would be if values between the ends of the range were uniformly distributed, then search gallops
+* from probe towards item (16, 32, 64, ... elements), so both ends of the range close around item and the next interpolation is exact.
+* Plain interpolation search moves only one end and converges slowly from one side, this one needs O(log log n) rounds
+* for uniform keys, each of them mostly in cache lines near the probe. Skewed keys could make it slow, so after log log n + 2 rounds
+* (or once the range is small) the rest is bisected by lower_bound
+*/
+template<class T>
+inline size_t interpolation_lower_bound(const T* arr, const size_t& size, const T& item)
+{
+	static_assert(std::is_arithmetic<T>::value, "Interpolation search needs numbers");
+
+	size_t low = 0, high = size; //result is in [low, high]
+	const int log_size = 64 - bit_leading_zeros(size);
+	const int max_rounds = 66 - bit_leading_zeros((uint64_t)log_size);
+	for (int round = 0; round < max_rounds && high - low > 16; round++)
+	{
+		if (!(arr[low] < item))
+			return low;
+		if (arr[high - 1] < item)
+			return high;
+
+		//arr[low] < item <= arr[high - 1], so fraction is in (0, 1]
+		const double fraction = ((double)item - (double)arr[low]) / ((double)arr[high - 1] - (double)arr[low]);
+		size_t probe = low + (size_t)(fraction * (double)(high - 1 - low));
+		if (probe >= high) //rounding
+			probe = high - 1;
+
+		size_t step = 16;
+		if (arr[probe] < item)
+		{
+			low = probe + 1;
+			while (step < high - low)
+			{
+				if (!(arr[low + step - 1] < item))
+				{
+					high = low + step - 1;
+					break;
+				}
+				low += step;
+				step *= 2;
+			}
+		}
+		else
+		{
+			high = probe;
+			while (step < high - low)
+			{
+				if (arr[high - step] < item)
+				{
+					low = high - step + 1;
+					break;
+				}
+				high -= step;
+				step *= 2;
+			}
+		}
+	}
+	return low + lower_bound(arr + low, high - low, item);
+}
+
+/*
+* Interpolation search, returns true if item is in ascending array of numbers, see interpolation_lower_bound
+*/
+template<class T>
+inline bool interpolation_search(const T* arr, const size_t& size, const T& item)
+{
+	const size_t i = interpolation_lower_bound(arr, size, item);
+	return i < size && !(item < arr[i]);
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <functional>
+#include "Utility/simd.h"
+#include "Algorithms/Searching/binary_search.h"
+
+/*
+* Lower bound of item in sorted array when its position is expected near guess, within epsilon
+* Bisects window [guess - epsilon, guess + epsilon + 1], if result is at edge of window (prediction was worse than epsilon,
+* for example inside long run of duplicates) it gallops out of window, so result is always exact
+*/
+template<class T, class Comparator = std::less<T>>
+inline size_t window_lower_bound(const T* arr, const size_t& size, const T& item, const size_t& guess, const size_t& epsilon, Comparator comp = Comparator())
+{
+	size_t low = guess > epsilon ? std::min(size, guess - epsilon) : 0;
+	size_t high = std::min(size, guess + epsilon + 2);
+	size_t step = epsilon + 1;
+	while (low > 0 && !comp(arr[low - 1], item)) //result is before window
+	{
+		high = low;
+		low = low > step ? low - step : 0;
+		step *= 2;
+	}
+	const size_t i = low + lower_bound(arr + low, high - low, item, comp);
+	if (i == high && high < size) //result is after window
+		return exponential_lower_bound(arr, size, high, item, comp);
+	return i;
+}
+
+/// <summary>
+/// Learned index over sorted array of numbers (PGM index of Ferragina and Vinciguerra), predicts position of key
+/// by piecewise linear model with error at most epsilon, then searches only window of 2 epsilon + 2 items around prediction
+/// Segments are built in one pass over distinct keys with shrinking cone: segment starts at its first key and is extended
+/// while some slope keeps every key within epsilon of its position. Segments are indexed recursively by the same model
+/// over their first keys, until one segment is left, so query does few window searches instead of log n probes over whole array
+/// Model uses O(n / epsilon) memory at worst and much less for smooth keys, array is not copied and has to stay unchanged
+/// Window searches are exact and fall back to galloping, so queries are correct even where model is off (runs of duplicates)
+/// </summary>
+template<class T>
+class LearnedIndex
+{
+private:
+	//segments of one level, struct of arrays, so window searches touch only keys
+	struct Level
+	{
+		std::vector<T> keys; //first key of every segment
+		std::vector<double> slopes;
+		std::vector<size_t> positions; //position of first key in level below (or in array)
+	};
+
+	const T* _arr = nullptr;
+	size_t n = 0;
+	size_t _epsilon = 64;
+	std::vector<Level> levels; //levels[0] indexes array, the last level has one segment
+
+	//builds segments over count sorted keys, key(i) is ith key, keys that equal the previous one are skipped
+	template<class Key>
+	Level build_level(const size_t& count, Key key)
+	{
+		Level level;
+		size_t x = 0;
+		while (x < count)
+		{
+			const T first = key(x);
+			const double origin = (double)first;
+			const size_t start = x;
+			double low_slope = 0, high_slope = std::numeric_limits<double>::infinity();
+			for (x++; x < count; x++)
+			{
+				const T current = key(x);
+				if (!(key(x - 1) < current))
+					continue;
+				const double dx = (double)current - origin;
+				const double dy = (double)(x - start);
+				if (dx <= 0) //keys too close for double, segment cannot separate them
+				{
+					if (dy > _epsilon)
+						break;
+					continue;
+				}
+				const double low = std::max(low_slope, (dy - _epsilon) / dx);
+				const double high = std::min(high_slope, (dy + _epsilon) / dx);
+				if (low > high)
+					break;
+				low_slope = low;
+				high_slope = high;
+			}
+			level.keys.push_back(first);
+			level.slopes.push_back(high_slope == std::numeric_limits<double>::infinity() ? 0 : (low_slope + high_slope) / 2);
+			level.positions.push_back(start);
+		}
+		return level;
+	}
+
+	//position of item predicted by segment s of level
+	size_t predict(const Level& level, const size_t& s, const T& item, const size_t& limit) const
+	{
+		const double position = (double)level.positions[s] + level.slopes[s] * ((double)item - (double)level.keys[s]);
+		if (!(position > 0))
+			return 0;
+		return position >= (double)limit ? limit : (size_t)position;
+	}
+public:
+	/// <param name="sorted">Ascending array, it is not copied</param>
+	/// <param name="epsilon">Maximal error of model, smaller epsilon makes searched windows smaller and model larger</param>
+	LearnedIndex(const T* sorted, const size_t& size, const size_t& epsilon = 64) : _arr(sorted), n(size), _epsilon(std::max((size_t)1, epsilon))
+	{
+		static_assert(std::is_arithmetic<T>::value, "Learned index needs numbers");
+		if (sorted == nullptr && size > 0) throw std::invalid_argument("Array cannot be nullptr");
+		if (n == 0)
+			return;
+
+		levels.push_back(build_level(n, [sorted](const size_t& i) { return sorted[i]; }));
+		while (levels.back().keys.size() > 1)
+		{
+			const std::vector<T>& keys = levels.back().keys;
+			Level next = build_level(keys.size(), [&keys](const size_t& i) { return keys[i]; });
+			levels.push_back(std::move(next));
+		}
+	}
+
+	size_t GetSize() const { return n; }
+	size_t GetEpsilon() const { return _epsilon; }
+	size_t GetLevelCount() const { return levels.size(); }
+	size_t GetSegmentCount() const { return levels.empty() ? 0 : levels[0].keys.size(); }
+
+	//number of bytes used by model, array is not counted
+	size_t MemoryUsage() const
+	{
+		size_t bytes = 0;
+		for (auto& level : levels)
+			bytes += level.keys.capacity() * sizeof(T) + level.slopes.capacity() * sizeof(double) + level.positions.capacity() * sizeof(size_t);
+		return bytes;
+	}
+
+	/// <summary>
+	/// Returns position of the first item of array that is not less than item, GetSize() if there is none
+	/// </summary>
+	size_t LowerBound(const T& item) const
+	{
+		if (n == 0)
+			return 0;
+
+		//segment of item on every level is the last one whose first key is not greater than item
+		auto not_greater = [](const T& a, const T& b) { return !(b < a); };
+		size_t s = 0;
+		for (size_t l = levels.size() - 1; l > 0; l--)
+		{
+			const std::vector<T>& keys = levels[l - 1].keys;
+			const size_t guess = predict(levels[l], s, item, keys.size());
+			const size_t after = window_lower_bound(keys.data(), keys.size(), item, guess, _epsilon, not_greater);
+			s = after > 0 ? after - 1 : 0;
+		}
+		//window of the array is several cache lines, they are loaded together instead of one miss per bisection step
+		const size_t guess = predict(levels[0], s, item, n);
+		const char* first = (const char*)(_arr + (guess > _epsilon ? std::min(n - 1, guess - _epsilon) : 0));
+		const char* last = (const char*)(_arr + std::min(n, guess + _epsilon + 2));
+		for (; first < last; first += 64)
+			simd_prefetch(first);
+		return window_lower_bound(_arr, n, item, guess, _epsilon);
+	}
+
+	//returns true if item is in the array
+	bool Contains(const T& item) const
+	{
+		const size_t i = LowerBound(item);
+		return i < n && !(item < _arr[i]);
+	}
+};
@@ -1,11 +1,340 @@
 #pragma once
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include "Utility/simd.h"
+#include "Algorithms/Searching/binary_search.h"
 
+//vector operations used by linear search kernels, equal returns bit mask with bit i set if lane i of a equals lane i of b
+#if SIMD_X86
 template<class T>
-inline bool linear_search(T* arr, const size_t& size, const T& item)
+struct LinearSseInt32
 {
-	for (int x = 0; x < size; x++)
+	typedef __m128i V;
+	enum { lanes = 4 };
+	SIMD_TARGET_SSE41 static V load(const T* p) { return _mm_loadu_si128((const __m128i*)p); }
+	SIMD_TARGET_SSE41 static V set1(const T& item) { return _mm_set1_epi32((int)item); }
+	SIMD_TARGET_SSE41 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+};
+
+template<class T>
+struct LinearSseInt64
+{
+	typedef __m128i V;
+	enum { lanes = 2 };
+	SIMD_TARGET_SSE41 static V load(const T* p) { return _mm_loadu_si128((const __m128i*)p); }
+	SIMD_TARGET_SSE41 static V set1(const T& item) { return _mm_set1_epi64x((long long)item); }
+	SIMD_TARGET_SSE41 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(a, b))); }
+};
+
+struct LinearSseFloat
+{
+	typedef __m128 V;
+	enum { lanes = 4 };
+	SIMD_TARGET_SSE41 static V load(const float* p) { return _mm_loadu_ps(p); }
+	SIMD_TARGET_SSE41 static V set1(const float& item) { return _mm_set1_ps(item); }
+	SIMD_TARGET_SSE41 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+};
+
+struct LinearSseDouble
+{
+	typedef __m128d V;
+	enum { lanes = 2 };
+	SIMD_TARGET_SSE41 static V load(const double* p) { return _mm_loadu_pd(p); }
+	SIMD_TARGET_SSE41 static V set1(const double& item) { return _mm_set1_pd(item); }
+	SIMD_TARGET_SSE41 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+};
+
+template<class T>
+struct LinearAvx2Int32
+{
+	typedef __m256i V;
+	enum { lanes = 8 };
+	SIMD_TARGET_AVX2 static V load(const T* p) { return _mm256_loadu_si256((const __m256i*)p); }
+	SIMD_TARGET_AVX2 static V set1(const T& item) { return _mm256_set1_epi32((int)item); }
+	SIMD_TARGET_AVX2 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+};
+
+template<class T>
+struct LinearAvx2Int64
+{
+	typedef __m256i V;
+	enum { lanes = 4 };
+	SIMD_TARGET_AVX2 static V load(const T* p) { return _mm256_loadu_si256((const __m256i*)p); }
+	SIMD_TARGET_AVX2 static V set1(const T& item) { return _mm256_set1_epi64x((long long)item); }
+	SIMD_TARGET_AVX2 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b))); }
+};
+
+struct LinearAvx2Float
+{
+	typedef __m256 V;
+	enum { lanes = 8 };
+	SIMD_TARGET_AVX2 static V load(const float* p) { return _mm256_loadu_ps(p); }
+	SIMD_TARGET_AVX2 static V set1(const float& item) { return _mm256_set1_ps(item); }
+	SIMD_TARGET_AVX2 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+};
+
+struct LinearAvx2Double
+{
+	typedef __m256d V;
+	enum { lanes = 4 };
+	SIMD_TARGET_AVX2 static V load(const double* p) { return _mm256_loadu_pd(p); }
+	SIMD_TARGET_AVX2 static V set1(const double& item) { return _mm256_set1_pd(item); }
+	SIMD_TARGET_AVX2 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+};
+#endif
+
+//types with vectorized linear search kernels: 32 and 64 bit integers, float and double, other types use scalar loops
+template<class T, class Enable = void>
+struct LinearSearchOps
+{
+	static const bool vectorized = false;
+};
+
+#if SIMD_X86
+template<class T>
+struct LinearSearchOps<T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 4>::type>
+{
+	static const bool vectorized = true;
+	typedef LinearSseInt32<T> Sse;
+	typedef LinearAvx2Int32<T> Avx2;
+};
+
+template<class T>
+struct LinearSearchOps<T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 8>::type>
+{
+	static const bool vectorized = true;
+	typedef LinearSseInt64<T> Sse;
+	typedef LinearAvx2Int64<T> Avx2;
+};
+
+template<>
+struct LinearSearchOps<float>
+{
+	static const bool vectorized = true;
+	typedef LinearSseFloat Sse;
+	typedef LinearAvx2Float Avx2;
+};
+
+template<>
+struct LinearSearchOps<double>
+{
+	static const bool vectorized = true;
+	typedef LinearSseDouble Sse;
+	typedef LinearAvx2Double Avx2;
+};
+#endif
+
+//keys compared in single pass of linear_contains_any kernels, more keys are sorted and bisected
+const size_t linear_search_max_keys = 16;
+
+template<class T>
+long long linear_find_scalar(const T* arr, const size_t& begin, const size_t& size, const T& item)
+{
+	for (size_t x = begin; x < size; x++)
 		if (arr[x] == item)
-			return true;
+			return (long long)x;
+	return -1;
+}
+
+template<class T>
+size_t linear_count_scalar(const T* arr, const size_t& begin, const size_t& size, const T& item)
+{
+	size_t count = 0;
+	for (size_t x = begin; x < size; x++)
+		count += arr[x] == item;
+	return count;
+}
+
+template<class T>
+long long linear_contains_any_scalar(const T* arr, const size_t& begin, const size_t& size, const T* keys, const size_t& key_count)
+{
+	for (size_t x = begin; x < size; x++)
+		for (size_t k = 0; k < key_count; k++)
+			if (arr[x] == keys[k])
+				return (long long)x;
+	return -1;
+}
+
+#if SIMD_X86
+/// <summary>
+/// Kernels of linear search, 4 vectors are compared per iteration and their masks are tested together,
+/// so the loop has one predictable branch per 4 vectors. Elements after the last full vector are searched by scalar loop
+/// The kernels are defined once and stamped for SSE4.1 (linear_*_sse) and AVX2 (linear_*_avx2), since the target attribute belongs to each function
+/// </summary>
+#define LINEAR_SEARCH_KERNELS(suffix, target) \
+template<class Ops, class T> \
+target long long linear_find_##suffix(const T* arr, const size_t& size, const T& item) \
+{ \
+	typedef typename Ops::V V; \
+	const size_t lanes = Ops::lanes; \
+	const V key = Ops::set1(item); \
+	size_t x = 0; \
+	for (; x + 4 * lanes <= size; x += 4 * lanes) \
+	{ \
+		const uint64_t mask = (uint64_t)Ops::equal(Ops::load(arr + x), key) | ((uint64_t)Ops::equal(Ops::load(arr + x + lanes), key) << lanes) \
+			| ((uint64_t)Ops::equal(Ops::load(arr + x + 2 * lanes), key) << (2 * lanes)) | ((uint64_t)Ops::equal(Ops::load(arr + x + 3 * lanes), key) << (3 * lanes)); \
+		if (mask != 0) \
+			return (long long)(x + bit_trailing_zeros(mask)); \
+	} \
+	for (; x + lanes <= size; x += lanes) \
+	{ \
+		const unsigned int mask = Ops::equal(Ops::load(arr + x), key); \
+		if (mask != 0) \
+			return (long long)(x + bit_trailing_zeros(mask)); \
+	} \
+	return linear_find_scalar(arr, x, size, item); \
+} \
+ \
+template<class Ops, class T> \
+target size_t linear_count_##suffix(const T* arr, const size_t& size, const T& item) \
+{ \
+	typedef typename Ops::V V; \
+	const size_t lanes = Ops::lanes; \
+	const V key = Ops::set1(item); \
+	size_t count = 0, x = 0; \
+	for (; x + 4 * lanes <= size; x += 4 * lanes) \
+	{ \
+		const uint64_t mask = (uint64_t)Ops::equal(Ops::load(arr + x), key) | ((uint64_t)Ops::equal(Ops::load(arr + x + lanes), key) << lanes) \
+			| ((uint64_t)Ops::equal(Ops::load(arr + x + 2 * lanes), key) << (2 * lanes)) | ((uint64_t)Ops::equal(Ops::load(arr + x + 3 * lanes), key) << (3 * lanes)); \
+		count += bit_popcount(mask); \
+	} \
+	for (; x + lanes <= size; x += lanes) \
+		count += bit_popcount(Ops::equal(Ops::load(arr + x), key)); \
+	return count + linear_count_scalar(arr, x, size, item); \
+} \
+ \
+template<class Ops, class T> \
+target long long linear_contains_any_##suffix(const T* arr, const size_t& size, const T* keys, const size_t& key_count) \
+{ \
+	typedef typename Ops::V V; \
+	const size_t lanes = Ops::lanes; \
+	V key_vectors[linear_search_max_keys]; \
+	for (size_t k = 0; k < key_count; k++) \
+		key_vectors[k] = Ops::set1(keys[k]); \
+	size_t x = 0; \
+	for (; x + lanes <= size; x += lanes) \
+	{ \
+		const V items = Ops::load(arr + x); \
+		unsigned int mask = 0; \
+		for (size_t k = 0; k < key_count; k++) \
+			mask |= Ops::equal(items, key_vectors[k]); \
+		if (mask != 0) \
+			return (long long)(x + bit_trailing_zeros(mask)); \
+	} \
+	return linear_contains_any_scalar(arr, x, size, keys, key_count); \
+}
+
+LINEAR_SEARCH_KERNELS(sse, SIMD_TARGET_SSE41)
+LINEAR_SEARCH_KERNELS(avx2, SIMD_TARGET_AVX2)
+#undef LINEAR_SEARCH_KERNELS
+#endif
+
+template<class T>
+long long linear_find_dispatch(const T* arr, const size_t& size, const T& item, std::false_type) { return linear_find_scalar(arr, 0, size, item); }
+
+template<class T>
+long long linear_find_dispatch(const T* arr, const size_t& size, const T& item, std::true_type)
+{
+#if SIMD_X86
+	typedef LinearSearchOps<T> Ops;
+	const SimdLevel level = simd_level();
+	if (level == SimdLevel::AVX2)
+		return linear_find_avx2<typename Ops::Avx2>(arr, size, item);
+	if (level == SimdLevel::SSE41)
+		return linear_find_sse<typename Ops::Sse>(arr, size, item);
+#endif
+	return linear_find_scalar(arr, 0, size, item);
+}
+
+template<class T>
+size_t linear_count_dispatch(const T* arr, const size_t& size, const T& item, std::false_type) { return linear_count_scalar(arr, 0, size, item); }
+
+template<class T>
+size_t linear_count_dispatch(const T* arr, const size_t& size, const T& item, std::true_type)
+{
+#if SIMD_X86
+	typedef LinearSearchOps<T> Ops;
+	const SimdLevel level = simd_level();
+	if (level == SimdLevel::AVX2)
+		return linear_count_avx2<typename Ops::Avx2>(arr, size, item);
+	if (level == SimdLevel::SSE41)
+		return linear_count_sse<typename Ops::Sse>(arr, size, item);
+#endif
+	return linear_count_scalar(arr, 0, size, item);
+}
+
+template<class T>
+long long linear_contains_any_dispatch(const T* arr, const size_t& size, const T* keys, const size_t& key_count, std::false_type)
+{
+	return linear_contains_any_scalar(arr, 0, size, keys, key_count);
+}
+
+template<class T>
+long long linear_contains_any_dispatch(const T* arr, const size_t& size, const T* keys, const size_t& key_count, std::true_type)
+{
+#if SIMD_X86
+	typedef LinearSearchOps<T> Ops;
+	const SimdLevel level = simd_level();
+	if (level == SimdLevel::AVX2)
+		return linear_contains_any_avx2<typename Ops::Avx2>(arr, size, keys, key_count);
+	if (level == SimdLevel::SSE41)
+		return linear_contains_any_sse<typename Ops::Sse>(arr, size, keys, key_count);
+#endif
+	return linear_contains_any_scalar(arr, 0, size, keys, key_count);
+}
+
+/// <summary>
+/// Returns index of the first element equal to item, -1 if there is none. Array does not have to be sorted
+/// 32 and 64 bit integers, float and double are compared 8 or 4 at once with AVX2 (or SSE4.1, detected at runtime),
+/// other types by scalar loop. Floats are compared as numbers, so -0.0 == 0.0 and NaN is never found
+/// </summary>
+template<class T>
+long long linear_find(const T* arr, const size_t& size, const T& item)
+{
+	if (arr == nullptr && size > 0) throw std::invalid_argument("Array cannot be nullptr");
+	return linear_find_dispatch(arr, size, item, std::integral_constant<bool, LinearSearchOps<T>::vectorized>());
+}
+
+/// <summary>
+/// Returns number of elements equal to item, vectorized as linear_find
+/// </summary>
+template<class T>
+size_t linear_count(const T* arr, const size_t& size, const T& item)
+{
+	if (arr == nullptr && size > 0) throw std::invalid_argument("Array cannot be nullptr");
+	return linear_count_dispatch(arr, size, item, std::integral_constant<bool, LinearSearchOps<T>::vectorized>());
+}
+
+/// <summary>
+/// Returns index of the first element equal to any of keys, -1 if there is none
+/// Up to 16 keys every vector of array is compared with every key, with more keys they are sorted
+/// and every element is looked up by lower_bound, so keys have to be comparable with operator&lt;
+/// </summary>
+template<class T>
+long long linear_contains_any(const T* arr, const size_t& size, const T* keys, const size_t& key_count)
+{
+	if ((arr == nullptr && size > 0) || (keys == nullptr && key_count > 0)) throw std::invalid_argument("Array cannot be nullptr");
+	if (key_count <= linear_search_max_keys)
+		return linear_contains_any_dispatch(arr, size, keys, key_count, std::integral_constant<bool, LinearSearchOps<T>::vectorized>());
+
+	std::vector<T> sorted(keys, keys + key_count);
+	std::sort(sorted.begin(), sorted.end());
+	for (size_t x = 0; x < size; x++)
+	{
+		const size_t i = lower_bound(sorted.data(), key_count, arr[x]);
+		if (i < key_count && sorted[i] == arr[x])
+			return (long long)x;
+	}
+	return -1;
+}
 
-	return false;
+/// <summary>
+/// Returns true if item is in the array, see linear_find
+/// </summary>
+template<class T>
+inline bool linear_search(const T* arr, const size_t& size, const T& item)
+{
+	return linear_find(arr, size, item) >= 0;
 }
@@ -0,0 +1,208 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include "Utility/testing.h"
+#include "Utility/benchmark.h"
+#include "Utility/simd.h"
+#include "order_statistics.h"
+#include "min_max.h"
+
+//equal values, or both NaN
+template<class T>
+bool min_max_same(const T& a, const T& b) { return a == b || (min_max_is_nan(a) && min_max_is_nan(b)); }
+
+/// <summary>
+/// Checks every min_max function on arr against std::min_element and std::max_element, when arr has NaN against
+/// the first minimum and maximum of elements that are not NaN (index 0 if every element is NaN)
+/// </summary>
+template<class T>
+void check_min_max(TestReport& report, const std::vector<T>& arr, const std::string& name)
+{
+	const size_t size = arr.size();
+	const bool has_nan = std::any_of(arr.begin(), arr.end(), [](const T& item) { return min_max_is_nan(item); });
+	size_t first_min = std::min_element(arr.begin(), arr.end()) - arr.begin();
+	size_t first_max = std::max_element(arr.begin(), arr.end()) - arr.begin();
+	if (has_nan)
+	{
+		first_min = min_max_arg_scalar<T, false>(arr.data(), 0, size);
+		first_max = min_max_arg_scalar<T, true>(arr.data(), 0, size);
+		first_min = first_min == size ? 0 : first_min;
+		first_max = first_max == size ? 0 : first_max;
+	}
+	const T min = arr[first_min], max = arr[first_max];
+
+	report.check(min_max_same(simd_min(arr.data(), size), min), name + " simd_min");
+	report.check(min_max_same(simd_max(arr.data(), size), max), name + " simd_max");
+	const std::pair<T, T> both = simd_minmax(arr.data(), size);
+	report.check(min_max_same(both.first, min) && min_max_same(both.second, max), name + " simd_minmax");
+	report.check(simd_argmin(arr.data(), size) == first_min, name + " simd_argmin returned " + std::to_string(simd_argmin(arr.data(), size)) + ", expected " + std::to_string(first_min));
+	report.check(simd_argmax(arr.data(), size) == first_max, name + " simd_argmax returned " + std::to_string(simd_argmax(arr.data(), size)) + ", expected " + std::to_string(first_max));
+	if (!has_nan) //pairwise functions of order_statistics.h compare NaN as any other value
+	{
+		const std::pair<size_t, size_t> std_minmax(std::minmax_element(arr.begin(), arr.end()).first - arr.begin(), std::minmax_element(arr.begin(), arr.end()).second - arr.begin());
+		report.check(arg_minmax(arr.data(), size) == std_minmax, name + " arg_minmax");
+		report.check(arg_minmax(arr.data(), size, std::greater<T>()) == std::make_pair(first_max, size - 1 - (size_t)(std::find(arr.rbegin(), arr.rend(), min) - arr.rbegin())), name + " arg_minmax>");
+		std::vector<T> copy(arr);
+		report.check(minmax(copy.data(), size) == std::make_pair(min, max), name + " minmax");
+	}
+
+	for (unsigned int thread_count : { 1u, 3u })
+	{
+		const std::string threads = name + " threads=" + std::to_string(thread_count);
+		report.check(min_max_same(parallel_min(arr.data(), size, thread_count), min), threads + " parallel_min");
+		report.check(min_max_same(parallel_max(arr.data(), size, thread_count), max), threads + " parallel_max");
+		const std::pair<T, T> parallel_both = parallel_minmax(arr.data(), size, thread_count);
+		report.check(min_max_same(parallel_both.first, min) && min_max_same(parallel_both.second, max), threads + " parallel_minmax");
+		report.check(parallel_argmin(arr.data(), size, thread_count) == first_min, threads + " parallel_argmin");
+		report.check(parallel_argmax(arr.data(), size, thread_count) == first_max, threads + " parallel_argmax");
+	}
+}
+
+/// <summary>
+/// Checks floating point special values: NaN at the first, last and random positions and in whole blocks (NaN is skipped),
+/// arrays of only NaN, infinities, and negative and positive zero (equal, so the first zero is the minimum)
+/// </summary>
+template<class T>
+void check_min_max_special(TestReport& report, const size_t& size, std::mt19937_64& gen, const std::string& name)
+{
+	const T nan = std::numeric_limits<T>::quiet_NaN(), inf = std::numeric_limits<T>::infinity();
+	std::vector<T> arr(size);
+	std::uniform_int_distribution<int> dist(-500, 500);
+	auto fill = [&]() {
+		for (auto& item : arr)
+			item = (T)dist(gen);
+	};
+
+	fill();
+	arr[0] = nan;
+	check_min_max(report, arr, name + " NaN first");
+	fill();
+	arr[size - 1] = nan;
+	check_min_max(report, arr, name + " NaN last");
+	fill();
+	for (size_t x = 0; x < size; x += 1 + gen() % 7)
+		arr[x] = nan;
+	check_min_max(report, arr, name + " NaN scattered");
+	fill();
+	std::fill(arr.begin(), arr.begin() + std::min(size, (size_t)5000), nan);
+	check_min_max(report, arr, name + " NaN block");
+	std::fill(arr.begin(), arr.end(), nan);
+	check_min_max(report, arr, name + " only NaN");
+
+	fill();
+	arr[gen() % size] = inf;
+	arr[gen() % size] = -inf;
+	check_min_max(report, arr, name + " infinities");
+	std::fill(arr.begin(), arr.end(), -inf);
+	arr[gen() % size] = nan;
+	check_min_max(report, arr, name + " -inf and NaN");
+
+	for (size_t x = 0; x < size; x++)
+		arr[x] = gen() % 2 ? (T)-0.0 : (T)0.0;
+	check_min_max(report, arr, name + " signed zeros");
+	arr[gen() % size] = nan;
+	check_min_max(report, arr, name + " signed zeros and NaN");
+}
+
+/// <summary>
+/// Differential test of vectorized, parallel and pairwise min/max reductions against std::min_element and std::max_element
+/// Every instruction set supported by cpu is tested for int, float and double, sizes around vector widths check tails,
+/// values have many duplicates, so argmin and argmax have to return the first occurence, floating point arrays
+/// also get NaN, infinities and signed zeros
+/// </summary>
+/// <param name="seed">Seed of generated inputs</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_min_max_differential(const uint64_t& seed = 20240601)
+{
+	TestReport report("min/max differential");
+	const std::vector<size_t> sizes = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 65, 100, 4095, 4096, 4097, 10000, 300001 };
+	const SimdLevel detected = simd_detect_level();
+	const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE41, SimdLevel::AVX2 };
+
+	for (const SimdLevel& level : levels)
+	{
+		if (level > detected)
+			continue;
+		simd_limit_level(level);
+		for (const size_t& size : sizes)
+		{
+			for (const InputPattern& pattern : all_input_patterns)
+			{
+				std::mt19937_64 gen(seed ^ (size * 0x9E3779B97F4A7C15ull) ^ (uint64_t)pattern);
+				std::vector<int> ints(size);
+				fill_pattern(ints.data(), size, pattern, gen, 1000);
+				for (auto& item : ints)
+					item -= 500;
+				std::vector<float> floats(ints.begin(), ints.end());
+				std::vector<double> doubles(size);
+				for (size_t x = 0; x < size; x++)
+					doubles[x] = ints[x] * 0.25;
+
+				const std::string name = test_case_name("level " + std::to_string((int)level), pattern, size, seed);
+				check_min_max(report, ints, name + " int");
+				check_min_max(report, floats, name + " float");
+				check_min_max(report, doubles, name + " double");
+			}
+
+			std::mt19937_64 gen(seed ^ size);
+			const std::string name = "level " + std::to_string((int)level) + " size=" + std::to_string(size) + " seed=" + std::to_string(seed);
+			check_min_max_special<float>(report, size, gen, name + " float");
+			check_min_max_special<double>(report, size, gen, name + " double");
+		}
+	}
+	simd_limit_level(detected);
+
+	return report.summary();
+}
+
+/// <summary>
+/// Compares minmax of size random floats: scalar loop with two branches, pairwise minmax, std::minmax_element,
+/// simd_minmax with every supported instruction set and parallel_minmax, and argmin with std::min_element
+/// Results are printed in millions of items per second
+/// </summary>
+inline void bench_min_max(const size_t& size = 100000000, const uint64_t& seed = 20240601, const unsigned int& thread_count = 0)
+{
+	std::vector<float> arr(size);
+	std::mt19937_64 gen(seed);
+	std::uniform_real_distribution<float> dist(-1, 1);
+	for (auto& item : arr)
+		item = dist(gen);
+	volatile float sink = 0;
+	volatile size_t index_sink = 0;
+
+	std::cout << "Minimum and maximum of " << size << " floats:\n";
+	print_throughput("two branches", measure_throughput([&]() {
+		float min = arr[0], max = arr[0];
+		for (size_t x = 1; x < size; x++)
+		{
+			if (arr[x] > max) max = arr[x];
+			if (arr[x] < min) min = arr[x];
+		}
+		sink = min + max;
+	}, size, 3));
+	print_throughput("minmax (pairwise)", measure_throughput([&]() { auto result = minmax(arr.data(), size); sink = result.first + result.second; }, size, 3));
+	print_throughput("std::minmax_element", measure_throughput([&]() { auto result = std::minmax_element(arr.begin(), arr.end()); sink = *result.first + *result.second; }, size, 3));
+
+	const SimdLevel detected = simd_detect_level();
+	const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE41, SimdLevel::AVX2 };
+	for (const SimdLevel& level : levels)
+	{
+		if (level > detected)
+			continue;
+		simd_limit_level(level);
+		const std::string suffix = " level " + std::to_string((int)level);
+		print_throughput("simd_minmax" + suffix, measure_throughput([&]() { auto result = simd_minmax(arr.data(), size); sink = result.first + result.second; }, size, 3));
+		print_throughput("simd_min" + suffix, measure_throughput([&]() { sink = simd_min(arr.data(), size); }, size, 3));
+		print_throughput("simd_argmin" + suffix, measure_throughput([&]() { index_sink = simd_argmin(arr.data(), size); }, size, 3));
+	}
+	simd_limit_level(detected);
+
+	print_throughput("std::min_element", measure_throughput([&]() { index_sink = std::min_element(arr.begin(), arr.end()) - arr.begin(); }, size, 3));
+	print_throughput("parallel_minmax", measure_throughput([&]() { auto result = parallel_minmax(arr.data(), size, thread_count); sink = result.first + result.second; }, size, 3));
+	print_throughput("parallel_argmin", measure_throughput([&]() { index_sink = parallel_argmin(arr.data(), size, thread_count); }, size, 3));
+}
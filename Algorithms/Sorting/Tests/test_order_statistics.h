@@ -0,0 +1,313 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include "Utility/testing.h"
+#include "Utility/benchmark.h"
+#include "order_statistics.h"
+
+/// <summary>
+/// Selection algorithm under test, called as select(arr, size, i) and returns ith order statistic (i=1 -> minimum)
+/// </summary>
+struct SelectCase
+{
+	std::string name;
+	std::function<int(int*, const size_t&, const size_t&)> select;
+	bool descending; //true if algorithm selects using std::greater
+};
+
+//every selection algorithm in the repository
+inline std::vector<SelectCase> select_cases()
+{
+	return {
+		{ "ith_order",            [](int* arr, const size_t& size, const size_t& i) { return ith_order(arr, size, (unsigned)i); }, false },
+		{ "ith_order_recursive",  [](int* arr, const size_t& size, const size_t& i) { return ith_order_recursive(arr, size, (unsigned)i); }, false },
+		{ "select_ith",           [](int* arr, const size_t& size, const size_t& i) { return select_ith(arr, size, (unsigned)i); }, false },
+		{ "select_ith/7",         [](int* arr, const size_t& size, const size_t& i) { return select_ith(arr, size, (unsigned)i, 7); }, false },
+		{ "ith_order_introselect", [](int* arr, const size_t& size, const size_t& i) { return ith_order_introselect(arr, size, (unsigned)i); }, false },
+		{ "parallel_ith_order",   [](int* arr, const size_t& size, const size_t& i) { return parallel_ith_order(arr, size, i, 4); }, false },
+		{ "ith_order>",           [](int* arr, const size_t& size, const size_t& i) { return ith_order(arr, size, (unsigned)i, std::greater<int>()); }, true },
+		{ "ith_order_recursive>", [](int* arr, const size_t& size, const size_t& i) { return ith_order_recursive(arr, size, (unsigned)i, std::greater<int>()); }, true },
+		{ "select_ith>",          [](int* arr, const size_t& size, const size_t& i) { return select_ith(arr, size, (unsigned)i, 5, std::greater<int>()); }, true },
+		{ "ith_order_introselect>", [](int* arr, const size_t& size, const size_t& i) { return ith_order_introselect(arr, size, (unsigned)i, std::greater<int>()); }, true },
+		{ "parallel_ith_order>",  [](int* arr, const size_t& size, const size_t& i) { return parallel_ith_order(arr, size, i, 4, std::greater<int>()); }, true },
+	};
+}
+
+/// <summary>
+/// Differential test of every selection algorithm against std::nth_element
+/// Checks minimum, maximum, median and random ranks, and that input array is not modified
+/// </summary>
+/// <param name="seed">Seed of generated inputs</param>
+/// <param name="rounds">Number of rounds, every round uses different seed derived from seed</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_select_differential(const uint64_t& seed = 20240601, const int& rounds = 3)
+{
+	TestReport report("select differential");
+	const std::vector<size_t> sizes = { 1, 2, 3, 5, 11, 100, 1001, 5000 };
+
+	for (int round = 0; round < rounds; round++)
+	{
+		uint64_t round_seed = seed + round;
+		for (auto& select_case : select_cases())
+		{
+			for (const size_t& size : sizes)
+			{
+				for (const InputPattern& pattern : all_input_patterns)
+				{
+					std::mt19937_64 gen(round_seed ^ (size * 0x9E3779B97F4A7C15ull) ^ (uint64_t)pattern);
+					std::vector<int> arr(size);
+					fill_pattern(arr.data(), size, pattern, gen);
+					const std::vector<int> original = arr;
+
+					std::vector<size_t> ranks = { 1, size, (size + 1) / 2 };
+					for (int x = 0; x < 4; x++)
+						ranks.push_back(std::uniform_int_distribution<size_t>(1, size)(gen));
+
+					for (const size_t& i : ranks)
+					{
+						std::vector<int> expected = original;
+						if (select_case.descending)
+							std::nth_element(expected.begin(), expected.begin() + (i - 1), expected.end(), std::greater<int>());
+						else
+							std::nth_element(expected.begin(), expected.begin() + (i - 1), expected.end());
+
+						int out = select_case.select(arr.data(), size, i);
+						std::string name = test_case_name(select_case.name, pattern, size, round_seed) + " i=" + std::to_string(i);
+						report.check(out == expected[i - 1], name + " returned " + std::to_string(out) + ", expected " + std::to_string(expected[i - 1]));
+						report.check(arr == original, name + " has modified input array");
+					}
+				}
+			}
+		}
+	}
+
+	return report.summary();
+}
+
+/// <summary>
+/// Measures throughput of selection algorithms looking for median of random array and compares it with recorded baselines
+/// </summary>
+/// <returns>false if any algorithm has regressed</returns>
+inline bool test_select_performance(PerformanceBaseline& baseline, const size_t& size = 1000000, const uint64_t& seed = 20240601)
+{
+	TestReport report("select performance");
+	std::vector<int> arr(size);
+	std::mt19937_64 gen(seed);
+	fill_pattern(arr.data(), size, InputPattern::Random, gen);
+
+	for (auto& select_case : select_cases())
+	{
+		if (select_case.descending)
+			continue;
+
+		volatile int sink = 0;
+		double throughput = measure_throughput([&]() { sink = select_case.select(arr.data(), size, size / 2); }, size);
+		std::string name = "select/" + select_case.name + "/" + std::to_string(size);
+		print_throughput(name, throughput);
+		report.check(baseline.Check(name, throughput), name + " has regressed, baseline: " + std::to_string(baseline.GetBaseline(name)) + " items/s");
+	}
+
+	return report.summary();
+}
+
+/// <summary>
+/// Compares ith_order, select_ith, ith_order_introselect and std::nth_element looking for median of array of every input pattern
+/// All of them work on copy of input, std::nth_element copies array as well. Results are printed in millions of items per second
+/// </summary>
+inline void bench_select(const size_t& size = 10000000, const uint64_t& seed = 20240601)
+{
+	std::vector<int> arr(size);
+	std::vector<int> copy(size);
+	std::mt19937_64 gen(seed);
+	volatile int sink = 0;
+
+	for (const InputPattern& pattern : all_input_patterns)
+	{
+		fill_pattern(arr.data(), size, pattern, gen);
+		std::cout << "Median of " << size << " ints, " << input_pattern_name(pattern) << ":\n";
+		if (pattern != InputPattern::AllEqual && pattern != InputPattern::FewUnique) //quadratic on duplicates
+		{
+			print_throughput("ith_order", measure_throughput([&]() { sink = ith_order(arr.data(), size, (unsigned)(size / 2)); }, size, 3));
+			print_throughput("select_ith", measure_throughput([&]() { sink = select_ith(arr.data(), size, (unsigned)(size / 2)); }, size, 3));
+		}
+		print_throughput("ith_order_introselect", measure_throughput([&]() { sink = ith_order_introselect(arr.data(), size, (unsigned)(size / 2)); }, size, 3));
+		print_throughput("std::nth_element", measure_throughput([&]() {
+			std::copy(arr.begin(), arr.end(), copy.begin());
+			std::nth_element(copy.begin(), copy.begin() + size / 2, copy.end());
+			sink = copy[size / 2];
+		}, size, 3));
+	}
+}
+
+/// <summary>
+/// Differential test of multi_select against sorted copy, uses random sorted rank lists (with duplicates) and every input pattern
+/// Checks returned values and that elements between selected indexes are not out of place
+/// </summary>
+/// <returns>true if every check has passed</returns>
+inline bool test_multi_select_differential(const uint64_t& seed = 20240601, const int& rounds = 3)
+{
+	TestReport report("multi_select differential");
+	const std::vector<size_t> sizes = { 1, 2, 3, 5, 11, 100, 1001, 100000 };
+
+	for (int round = 0; round < rounds; round++)
+	{
+		uint64_t round_seed = seed + round;
+		for (const size_t& size : sizes)
+		{
+			for (const InputPattern& pattern : all_input_patterns)
+			{
+				std::mt19937_64 gen(round_seed ^ (size * 0x9E3779B97F4A7C15ull) ^ (uint64_t)pattern);
+				std::vector<int> arr(size);
+				fill_pattern(arr.data(), size, pattern, gen);
+				std::vector<int> sorted = arr;
+				std::sort(sorted.begin(), sorted.end());
+
+				std::vector<size_t> ranks = { 1, size };
+				const size_t rank_count = std::uniform_int_distribution<size_t>(0, 20)(gen);
+				for (size_t x = 0; x < rank_count; x++)
+					ranks.push_back(std::uniform_int_distribution<size_t>(1, size)(gen));
+				std::sort(ranks.begin(), ranks.end());
+
+				std::vector<int> out(ranks.size());
+				multi_select(arr.data(), size, ranks.data(), ranks.size(), out.data());
+
+				std::string name = test_case_name("multi_select", pattern, size, round_seed);
+				for (size_t x = 0; x < ranks.size(); x++)
+				{
+					report.check(out[x] == sorted[ranks[x] - 1], name + " rank " + std::to_string(ranks[x]) + " returned " + std::to_string(out[x]) + ", expected " + std::to_string(sorted[ranks[x] - 1]));
+					report.check(arr[ranks[x] - 1] == out[x], name + " rank " + std::to_string(ranks[x]) + " is not on its index");
+				}
+
+				//every element has to lie between its neighbouring selected elements
+				size_t next = 0;
+				bool in_place = true;
+				for (size_t x = 0; x < size; x++)
+				{
+					while (next < ranks.size() && ranks[next] - 1 < x)
+						next++;
+					if (next > 0 && arr[x] < arr[ranks[next - 1] - 1])
+						in_place = false;
+					if (next < ranks.size() && arr[ranks[next] - 1] < arr[x])
+						in_place = false;
+				}
+				report.check(in_place, name + " has elements out of place");
+			}
+		}
+	}
+
+	return report.summary();
+}
+
+/// <summary>
+/// Compares finding p50, p90, p99, p999 (and quantile_count evenly spread quantiles) with multi_select,
+/// repeated ith_order_introselect and repeated ith_order. Results are printed in millions of items per second
+/// </summary>
+inline void bench_multi_select(const size_t& size = 10000000, const size_t& quantile_count = 100, const uint64_t& seed = 20240601)
+{
+	std::vector<int> arr(size);
+	std::vector<int> copy(size);
+	std::mt19937_64 gen(seed);
+	fill_pattern(arr.data(), size, InputPattern::Random, gen);
+
+	std::vector<std::vector<double>> quantile_sets = { { 0.5, 0.9, 0.99, 0.999 }, {} };
+	for (size_t x = 1; x <= quantile_count; x++)
+		quantile_sets[1].push_back((double)x / (quantile_count + 1));
+
+	for (auto& quantiles : quantile_sets)
+	{
+		std::vector<int> out(quantiles.size());
+		std::vector<unsigned> ranks;
+		for (auto& q : quantiles)
+			ranks.push_back((unsigned)std::max(1.0, std::ceil(q * size)));
+
+		std::cout << quantiles.size() << " quantiles of " << size << " ints:\n";
+		print_throughput("multi_quantile", measure_throughput([&]() {
+			std::copy(arr.begin(), arr.end(), copy.begin());
+			multi_quantile(copy.data(), size, quantiles.data(), quantiles.size(), out.data());
+		}, size, 3));
+		print_throughput("ith_order_introselect per quantile", measure_throughput([&]() {
+			for (size_t x = 0; x < ranks.size(); x++)
+				out[x] = ith_order_introselect(arr.data(), size, ranks[x]);
+		}, size, 3));
+		print_throughput("ith_order per quantile", measure_throughput([&]() {
+			for (size_t x = 0; x < ranks.size(); x++)
+				out[x] = ith_order(arr.data(), size, ranks[x]);
+		}, size, 1));
+	}
+}
+
+/// <summary>
+/// Differential test of parallel_ith_order against std::nth_element on arrays large enough to be processed in parallel
+/// Uses every input pattern and different thread counts
+/// </summary>
+/// <returns>true if every check has passed</returns>
+inline bool test_parallel_select_differential(const uint64_t& seed = 20240601, const int& rounds = 2)
+{
+	TestReport report("parallel select differential");
+	const std::vector<size_t> sizes = { 1 << 15, 100000, 1000000 };
+	const std::vector<unsigned int> thread_counts = { 1, 2, 3, 8 };
+
+	for (int round = 0; round < rounds; round++)
+	{
+		uint64_t round_seed = seed + round;
+		for (const size_t& size : sizes)
+		{
+			for (const InputPattern& pattern : all_input_patterns)
+			{
+				std::mt19937_64 gen(round_seed ^ (size * 0x9E3779B97F4A7C15ull) ^ (uint64_t)pattern);
+				std::vector<int> arr(size);
+				fill_pattern(arr.data(), size, pattern, gen);
+				std::vector<int> sorted = arr;
+				std::sort(sorted.begin(), sorted.end());
+
+				std::vector<size_t> ranks = { 1, size, (size + 1) / 2, size / 100 + 1, size - size / 1000 };
+				for (const unsigned int& thread_count : thread_counts)
+				{
+					for (const size_t& i : ranks)
+					{
+						int out = parallel_ith_order(arr.data(), size, i, thread_count);
+						std::string name = test_case_name("parallel_ith_order/" + std::to_string(thread_count), pattern, size, round_seed) + " i=" + std::to_string(i);
+						report.check(out == sorted[i - 1], name + " returned " + std::to_string(out) + ", expected " + std::to_string(sorted[i - 1]));
+					}
+				}
+			}
+		}
+	}
+
+	return report.summary();
+}
+
+/// <summary>
+/// Measures median of size random floats with parallel_ith_order for 1, 2, 4, ... threads up to std::thread::hardware_concurrency(),
+/// and compares it with ith_order_introselect and std::nth_element on copy. Results are printed in millions of items per second
+/// </summary>
+inline void bench_parallel_select(const size_t& size = 100000000, const uint64_t& seed = 20240601)
+{
+	std::vector<float> arr(size);
+	std::mt19937_64 gen(seed);
+	std::uniform_real_distribution<float> dist(0, 1);
+	for (auto& item : arr)
+		item = dist(gen);
+	volatile float sink = 0;
+
+	std::cout << "Median of " << size << " floats:\n";
+	if (size <= UINT32_MAX)
+		print_throughput("ith_order_introselect", measure_throughput([&]() { sink = ith_order_introselect(arr.data(), size, (unsigned)(size / 2)); }, size, 3));
+	print_throughput("std::nth_element", measure_throughput([&]() {
+		std::vector<float> copy(arr);
+		std::nth_element(copy.begin(), copy.begin() + size / 2, copy.end());
+		sink = copy[size / 2];
+	}, size, 3));
+
+	const unsigned int max_threads = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned int thread_count = 1; ; thread_count = std::min(max_threads, thread_count * 2))
+	{
+		print_throughput("parallel_ith_order threads=" + std::to_string(thread_count), measure_throughput([&]() { sink = parallel_ith_order(arr.data(), size, size / 2, thread_count); }, size, 3));
+		if (thread_count == max_threads)
+			break;
+	}
+}
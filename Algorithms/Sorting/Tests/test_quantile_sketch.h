@@ -0,0 +1,110 @@
+#pragma once
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include "Utility/testing.h"
+#include "Utility/benchmark.h"
+#include "quantile_sketch.h"
+
+/// <summary>
+/// Returns largest difference between requested rank and real rank of returned item over quantiles 0.01, 0.02 ... 0.99, divided by size
+/// sorted has to be sorted copy of items inserted into sketch
+/// </summary>
+template<class T>
+double quantile_sketch_error(QuantileSketch<T>& sketch, const std::vector<T>& sorted)
+{
+	std::vector<double> quantiles;
+	for (int x = 1; x < 100; x++)
+		quantiles.push_back(x / 100.0);
+	std::vector<T> out(quantiles.size());
+	sketch.Quantiles(quantiles.data(), quantiles.size(), out.data());
+
+	double error = 0;
+	for (size_t x = 0; x < quantiles.size(); x++)
+	{
+		//item can occur many times, so any rank in [first, last] is correct
+		double first = (double)(std::lower_bound(sorted.begin(), sorted.end(), out[x]) - sorted.begin()) + 1;
+		double last = (double)(std::upper_bound(sorted.begin(), sorted.end(), out[x]) - sorted.begin());
+		double rank = quantiles[x] * sorted.size();
+		double distance = rank < first ? first - rank : rank > last ? rank - last : 0;
+		error = std::max(error, distance / sorted.size());
+	}
+	return error;
+}
+
+/// <summary>
+/// Tests QuantileSketch on every input pattern: small streams have to be answered exactly, large ones within 3/k relative rank error,
+/// merged sketches of halves of stream within the same error
+/// </summary>
+/// <returns>true if every check has passed</returns>
+inline bool test_quantile_sketch(const uint64_t& seed = 20240601)
+{
+	TestReport report("quantile sketch");
+	const size_t k = 200;
+
+	for (const InputPattern& pattern : all_input_patterns)
+	{
+		for (const size_t& size : { (size_t)100, (size_t)1000000 })
+		{
+			std::mt19937_64 gen(seed ^ (size * 0x9E3779B97F4A7C15ull) ^ (uint64_t)pattern);
+			std::vector<int> arr(size);
+			fill_pattern(arr.data(), size, pattern, gen);
+			std::vector<int> sorted = arr;
+			std::sort(sorted.begin(), sorted.end());
+			std::string name = test_case_name("QuantileSketch", pattern, size, seed);
+
+			QuantileSketch<int> sketch(k, seed);
+			sketch.InsertRange(arr.data(), size);
+			QuantileSketch<int> left(k, seed + 1), right(k, seed + 2);
+			for (size_t x = 0; x < size; x++)
+				(x < size / 2 ? left : right).Insert(arr[x]);
+			left.Merge(right);
+
+			report.check(sketch.GetCount() == size && left.GetCount() == size, name + " has wrong count");
+			report.check(sketch.Quantile(0) == sorted.front() && sketch.Quantile(1) == sorted.back(), name + " has wrong minimum or maximum");
+			if (sketch.IsExact())
+			{
+				for (size_t i = 1; i <= size; i += 7)
+					report.check(sketch.Ith(i) == sorted[i - 1], name + " exact sketch returned wrong " + std::to_string(i) + "th order statistic");
+			}
+			else report.check(sketch.MemoryUsage() < 4 * k, name + " keeps " + std::to_string(sketch.MemoryUsage()) + " items");
+
+			double error = quantile_sketch_error(sketch, sorted), merged_error = quantile_sketch_error(left, sorted);
+			report.check(error <= 3.0 / k, name + " has rank error " + std::to_string(error));
+			report.check(merged_error <= 3.0 / k, name + " merged has rank error " + std::to_string(merged_error));
+		}
+	}
+
+	return report.summary();
+}
+
+/// <summary>
+/// Prints memory, insert throughput and largest rank error over percentiles of QuantileSketch for different k,
+/// stream has size random doubles. Exact percentiles would need size * 8 bytes
+/// </summary>
+inline void bench_quantile_sketch(const size_t& size = 10000000, const uint64_t& seed = 20240601)
+{
+	std::vector<double> arr(size);
+	std::mt19937_64 gen(seed);
+	std::lognormal_distribution<double> dist(0, 1); //skewed as latencies
+	for (auto& item : arr)
+		item = dist(gen);
+	std::vector<double> sorted = arr;
+	std::sort(sorted.begin(), sorted.end());
+
+	std::cout << "QuantileSketch on " << size << " doubles, exact would use " << size * sizeof(double) << " B:\n";
+	const std::vector<size_t> ks = { 50, 100, 200, 400, 800, 1600 };
+	for (const size_t& k : ks)
+	{
+		QuantileSketch<double> sketch(k, seed);
+		double throughput = measure_throughput([&]() {
+			sketch = QuantileSketch<double>(k, seed);
+			sketch.InsertRange(arr.data(), size);
+		}, size, 3);
+		std::cout << "  k " << std::setw(5) << k << std::setw(10) << sketch.MemoryUsage() * sizeof(double) << " B  error "
+			<< std::setw(8) << quantile_sketch_error(sketch, sorted) * 100 << "%  " << throughput / 1e6 << " M items/s\n";
+	}
+}
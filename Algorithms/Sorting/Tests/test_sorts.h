@@ -0,0 +1,198 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include "Utility/testing.h"
+#include "Utility/benchmark.h"
+#include "Algorithms/Sorting/insertion_sort.h"
+#include "Algorithms/Sorting/selection_sort.h"
+#include "Algorithms/Sorting/bubble_sort.h"
+#include "Algorithms/Sorting/merge_sort.h"
+#include "Algorithms/Sorting/heapsort.h"
+#include "Algorithms/Sorting/quicksort.h"
+#include "Algorithms/Sorting/stooge_sort.h"
+#include "Algorithms/Sorting/counting_sort.h"
+#include "Algorithms/Sorting/lsd_radix_sort.h"
+
+/// <summary>
+/// Sorting algorithm under test, sort is called as sort(arr, size)
+/// </summary>
+template<class T>
+struct SortCase
+{
+	std::string name;
+	std::function<void(T*, const size_t&)> sort;
+	size_t max_size; //slow sorts are only tested on small arrays
+};
+
+//every sort in the repository sorting ints in ascending order
+inline std::vector<SortCase<int>> ascending_sort_cases()
+{
+	return {
+		{ "insertion_sort",       [](int* arr, const size_t& size) { insertion_sort(arr, (int)size); }, 5000 },
+		{ "selection_sort",       [](int* arr, const size_t& size) { selection_sort(arr, (int)size); }, 5000 },
+		{ "bubble_sort",          [](int* arr, const size_t& size) { bubble_sort(arr, (int)size); }, 5000 },
+		{ "merge_sort",           [](int* arr, const size_t& size) { merge_sort(arr, (int)size); }, SIZE_MAX },
+		{ "insertion_merge_sort", [](int* arr, const size_t& size) { insertion_merge_sort(arr, (int)size); }, SIZE_MAX },
+		{ "heapsort",             [](int* arr, const size_t& size) { heapsort(arr, size); }, SIZE_MAX },
+		{ "quicksort",            [](int* arr, const size_t& size) { quicksort(arr, size); }, SIZE_MAX },
+		{ "tre_quicksort",        [](int* arr, const size_t& size) { tre_quicksort(arr, size); }, SIZE_MAX },
+		{ "random_quicksort",     [](int* arr, const size_t& size) { random_quicksort(arr, size); }, SIZE_MAX },
+		{ "d_part_quicksort",     [](int* arr, const size_t& size) { d_part_quicksort(arr, size); }, SIZE_MAX },
+		{ "stooge_sort",          [](int* arr, const size_t& size) { stooge_sort(arr, size); }, 200 },
+		{ "counting_sort",        [](int* arr, const size_t& size) { counting_sort(arr, size); }, SIZE_MAX },
+		{ "radix_sort_int",       [](int* arr, const size_t& size) { radix_sort_int(arr, size); }, SIZE_MAX },
+	};
+}
+
+//every sort in the repository, that accepts comparator, sorting ints in descending order
+inline std::vector<SortCase<int>> descending_sort_cases()
+{
+	return {
+		{ "insertion_sort>",       [](int* arr, const size_t& size) { insertion_sort(arr, (int)size, std::greater<int>()); }, 5000 },
+		{ "selection_sort>",       [](int* arr, const size_t& size) { selection_sort(arr, (int)size, std::greater<int>()); }, 5000 },
+		{ "bubble_sort>",          [](int* arr, const size_t& size) { bubble_sort(arr, (int)size, std::greater<int>()); }, 5000 },
+		{ "merge_sort>",           [](int* arr, const size_t& size) { merge_sort(arr, (int)size, std::greater<int>()); }, SIZE_MAX },
+		{ "insertion_merge_sort>", [](int* arr, const size_t& size) { insertion_merge_sort(arr, (int)size, 8, std::greater<int>()); }, SIZE_MAX },
+		{ "heapsort>",             [](int* arr, const size_t& size) { heapsort(arr, size, std::greater<int>()); }, SIZE_MAX },
+		{ "quicksort>",            [](int* arr, const size_t& size) { quicksort(arr, size, std::greater<int>()); }, SIZE_MAX },
+		{ "tre_quicksort>",        [](int* arr, const size_t& size) { tre_quicksort(arr, size, std::greater<int>()); }, SIZE_MAX },
+		{ "random_quicksort>",     [](int* arr, const size_t& size) { random_quicksort(arr, size, std::greater<int>()); }, SIZE_MAX },
+		{ "d_part_quicksort>",     [](int* arr, const size_t& size) { d_part_quicksort(arr, size, std::greater<int>()); }, SIZE_MAX },
+		{ "stooge_sort>",          [](int* arr, const size_t& size) { stooge_sort(arr, size, std::greater<int>()); }, 200 },
+	};
+}
+
+/// <summary>
+/// Compares output of sort with std::sort on randomized inputs of every pattern and size
+/// </summary>
+template<class Comparator>
+void differential_sort_check(TestReport& report, SortCase<int>& sort_case, Comparator comp, const uint64_t& seed, const std::vector<size_t>& sizes)
+{
+	for (const size_t& size : sizes)
+	{
+		if (size > sort_case.max_size)
+			continue;
+
+		for (const InputPattern& pattern : all_input_patterns)
+		{
+			std::mt19937_64 gen(seed ^ (size * 0x9E3779B97F4A7C15ull) ^ (uint64_t)pattern);
+			std::vector<int> arr(size), expected;
+			fill_pattern(arr.data(), size, pattern, gen);
+			expected = arr;
+
+			std::sort(expected.begin(), expected.end(), comp);
+			sort_case.sort(arr.data(), size);
+			report.check(arr == expected, test_case_name(sort_case.name, pattern, size, seed) + " differs from std::sort");
+		}
+	}
+}
+
+/// <summary>
+/// Element used to check stability, only key is compared, index remembers original position
+/// </summary>
+struct StabilityItem
+{
+	int key = 0;
+	size_t index = 0;
+
+	bool operator==(const StabilityItem& other) const { return key == other.key && index == other.index; }
+};
+
+struct StabilityItemLess
+{
+	bool operator()(const StabilityItem& a, const StabilityItem& b) const { return a.key < b.key; }
+};
+
+//sorts that promise to keep the order of equal elements
+inline std::vector<SortCase<StabilityItem>> stable_sort_cases()
+{
+	return {
+		{ "insertion_sort",       [](StabilityItem* arr, const size_t& size) { insertion_sort(arr, (int)size, StabilityItemLess()); }, 5000 },
+		{ "bubble_sort",          [](StabilityItem* arr, const size_t& size) { bubble_sort(arr, (int)size, StabilityItemLess()); }, 5000 },
+		{ "merge_sort",           [](StabilityItem* arr, const size_t& size) { merge_sort(arr, (int)size, StabilityItemLess()); }, SIZE_MAX },
+		{ "insertion_merge_sort", [](StabilityItem* arr, const size_t& size) { insertion_merge_sort(arr, (int)size, 8, StabilityItemLess()); }, SIZE_MAX },
+	};
+}
+
+/// <summary>
+/// Compares output of stable sorts with std::stable_sort, inputs have many equal keys
+/// </summary>
+inline void stability_check(TestReport& report, const uint64_t& seed, const std::vector<size_t>& sizes)
+{
+	for (auto& sort_case : stable_sort_cases())
+	{
+		for (const size_t& size : sizes)
+		{
+			if (size > sort_case.max_size)
+				continue;
+
+			std::mt19937_64 gen(seed ^ size);
+			std::vector<int> keys(size);
+			fill_pattern(keys.data(), size, InputPattern::FewUnique, gen);
+
+			std::vector<StabilityItem> arr(size), expected;
+			for (size_t x = 0; x < size; x++)
+				arr[x] = { keys[x], x };
+			expected = arr;
+
+			std::stable_sort(expected.begin(), expected.end(), StabilityItemLess());
+			sort_case.sort(arr.data(), size);
+			report.check(arr == expected, test_case_name(sort_case.name, InputPattern::FewUnique, size, seed) + " is not stable");
+		}
+	}
+}
+
+/// <summary>
+/// Differential test of every sort in the repository against std::sort and std::stable_sort
+/// Failed cases print the seed, so they can be replayed
+/// </summary>
+/// <param name="seed">Seed of generated inputs</param>
+/// <param name="rounds">Number of rounds, every round uses different seed derived from seed</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_sorts_differential(const uint64_t& seed = 20240601, const int& rounds = 3)
+{
+	TestReport report("sorts differential");
+	const std::vector<size_t> sizes = { 1, 2, 3, 7, 16, 100, 1000, 5000, 20000 };
+
+	for (int round = 0; round < rounds; round++)
+	{
+		uint64_t round_seed = seed + round;
+		for (auto& sort_case : ascending_sort_cases())
+			differential_sort_check(report, sort_case, std::less<int>(), round_seed, sizes);
+		for (auto& sort_case : descending_sort_cases())
+			differential_sort_check(report, sort_case, std::greater<int>(), round_seed, sizes);
+		stability_check(report, round_seed, sizes);
+	}
+
+	return report.summary();
+}
+
+/// <summary>
+/// Measures throughput of the O(nlgn) sorts on random array and compares it with recorded baselines
+/// First run records baselines into the file, next runs fail if throughput drops more than baseline threshold
+/// </summary>
+/// <returns>false if any sort has regressed</returns>
+inline bool test_sorts_performance(PerformanceBaseline& baseline, const size_t& size = 200000, const uint64_t& seed = 20240601)
+{
+	TestReport report("sorts performance");
+	std::vector<int> input(size), arr(size);
+	std::mt19937_64 gen(seed);
+	fill_pattern(input.data(), size, InputPattern::Random, gen);
+
+	for (auto& sort_case : ascending_sort_cases())
+	{
+		if (size > sort_case.max_size)
+			continue;
+
+		double throughput = measure_throughput([&]() { arr = input; }, [&]() { sort_case.sort(arr.data(), size); }, size);
+		std::string name = "sort/" + sort_case.name + "/" + std::to_string(size);
+		print_throughput(name, throughput);
+		report.check(baseline.Check(name, throughput), name + " has regressed, baseline: " + std::to_string(baseline.GetBaseline(name)) + " items/s");
+	}
+
+	return report.summary();
+}
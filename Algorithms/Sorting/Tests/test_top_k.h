@@ -0,0 +1,109 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include "Utility/testing.h"
+#include "Utility/benchmark.h"
+#include "top_k.h"
+
+/// <summary>
+/// Differential test of top_k, streaming_top_k and merged TopK against std::partial_sort, for std::less and std::greater
+/// </summary>
+/// <param name="seed">Seed of generated inputs</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_top_k_differential(const uint64_t& seed = 20240601)
+{
+	TestReport report("top-k differential");
+	const std::vector<size_t> sizes = { 1, 2, 5, 100, 1001, 20000 };
+	const std::vector<size_t> ks = { 0, 1, 3, 100, 1000, 30000 };
+
+	for (const size_t& size : sizes)
+	{
+		for (const InputPattern& pattern : all_input_patterns)
+		{
+			std::mt19937_64 gen(seed ^ (size * 0x9E3779B97F4A7C15ull) ^ (uint64_t)pattern);
+			std::vector<int> arr(size);
+			fill_pattern(arr.data(), size, pattern, gen);
+
+			for (const size_t& k : ks)
+			{
+				const size_t kept = std::min(k, size);
+				const std::string name = test_case_name("top_k", pattern, size, seed) + " k=" + std::to_string(k);
+
+				std::vector<int> expected = arr;
+				std::partial_sort(expected.begin(), expected.begin() + kept, expected.end(), std::greater<int>());
+				expected.resize(kept);
+				std::vector<int> expected_smallest = arr;
+				std::partial_sort(expected_smallest.begin(), expected_smallest.begin() + kept, expected_smallest.end());
+				expected_smallest.resize(kept);
+
+				std::vector<int> in_place = arr;
+				top_k(in_place.data(), size, k);
+				report.check(std::vector<int>(in_place.begin(), in_place.begin() + kept) == expected, name + " in place");
+				std::sort(in_place.begin(), in_place.end());
+				std::vector<int> sorted = arr;
+				std::sort(sorted.begin(), sorted.end());
+				report.check(in_place == sorted, name + " in place is permutation");
+
+				in_place = arr;
+				top_k(in_place.data(), size, k, std::greater<int>());
+				report.check(std::vector<int>(in_place.begin(), in_place.begin() + kept) == expected_smallest, name + " in place>");
+
+				report.check(streaming_top_k(arr.data(), size, k) == expected, name + " streaming");
+				report.check(streaming_top_k(arr.data(), size, k, std::greater<int>()) == expected_smallest, name + " streaming>");
+
+				//stream split into two merged parts
+				TopK<int> first(k), second(k);
+				first.AddRange(arr.data(), size / 3);
+				for (size_t x = size / 3; x < size; x++)
+					second.Add(arr[x]);
+				first.Merge(second);
+				report.check(first.GetSorted() == expected && first.GetCount() == size, name + " merged");
+			}
+		}
+	}
+
+	return report.summary();
+}
+
+/// <summary>
+/// Compares top k of size random ints: std::partial_sort, std::nth_element + std::sort, top_k (all on copy of array),
+/// std::partial_sort_copy and streaming_top_k (without copy). Results are printed in millions of items per second
+/// </summary>
+inline void bench_top_k(const size_t& size = 10000000, const size_t& k = 100, const uint64_t& seed = 20240601)
+{
+	std::vector<int> arr(size);
+	std::mt19937_64 gen(seed);
+	std::uniform_int_distribution<int> dist(INT32_MIN, INT32_MAX);
+	for (auto& item : arr)
+		item = dist(gen);
+	std::vector<int> copy(size), out(k);
+	volatile int sink = 0;
+
+	std::cout << "Top " << k << " of " << size << " ints:\n";
+	print_throughput("copy only", measure_throughput([&]() { std::copy(arr.begin(), arr.end(), copy.begin()); sink = copy[0]; }, size, 3));
+	print_throughput("std::partial_sort", measure_throughput([&]() {
+		std::copy(arr.begin(), arr.end(), copy.begin());
+		std::partial_sort(copy.begin(), copy.begin() + k, copy.end(), std::greater<int>());
+		sink = copy[0];
+	}, size, 3));
+	print_throughput("std::nth_element + std::sort", measure_throughput([&]() {
+		std::copy(arr.begin(), arr.end(), copy.begin());
+		std::nth_element(copy.begin(), copy.begin() + (k - 1), copy.end(), std::greater<int>());
+		std::sort(copy.begin(), copy.begin() + k, std::greater<int>());
+		sink = copy[0];
+	}, size, 3));
+	print_throughput("top_k", measure_throughput([&]() {
+		std::copy(arr.begin(), arr.end(), copy.begin());
+		top_k(copy.data(), size, k);
+		sink = copy[0];
+	}, size, 3));
+	print_throughput("std::partial_sort_copy", measure_throughput([&]() {
+		std::partial_sort_copy(arr.begin(), arr.end(), out.begin(), out.end(), std::greater<int>());
+		sink = out[0];
+	}, size, 3));
+	print_throughput("streaming_top_k", measure_throughput([&]() { sink = streaming_top_k(arr.data(), size, k)[0]; }, size, 3));
+}
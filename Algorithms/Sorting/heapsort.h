@@ -1,18 +1,32 @@
 #pragma once
 #include "Data Structures/Heap.h"
 
+/// <summary>
+/// Swaps arguments of given comparator, heapsort builds max-heap (for std::less) to sort in ascending order
+/// </summary>
+template<class T, class Comp>
+struct heapsort_comparator
+{
+	Comp comp;
+	bool operator()(const T& a, const T& b) const { return comp(b, a); }
+};
+
 /// <summary>
 /// Sorting algorithm using heap properties to sort data
+/// Sorts in the same order as other sorts, std::less -> ascending
 /// </summary>
 template<class T, class Comp = std::less<T>>
 void heapsort(T* arr, const size_t& size, Comp comparator = Comp())
 {
-	Heap<T, Comp>::array_heapify(arr, size, comparator);
+	typedef heapsort_comparator<T, Comp> HeapComp;
+	HeapComp heap_comparator{ comparator };
+
+	Heap<T, HeapComp>::array_heapify(arr, size, heap_comparator);
 	size_t actual_size = size;
 	for (size_t x = size-1; x >0; x--)
 	{
 		std::swap(arr[0], arr[x]);
 		actual_size--;
-		Heap<T, Comp>::heapify(arr, actual_size, 0,comparator);//heapify from root node
+		Heap<T, HeapComp>::heapify(arr, actual_size, 0,heap_comparator);//heapify from root node
 	}
 }
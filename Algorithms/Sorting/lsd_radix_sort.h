@@ -1,17 +1,6 @@
 #pragma once
 #include <algorithm>
 
-/// <summary>
-/// Sorts array of integers using radix sort. Please note that this algorithm cannot sort properly floating point numbers
-/// </summary>
-template<class T = int>
-void radix_sort_int(T* arr, const size_t& arr_size) {
-	T max = *std::max_element(arr, arr + arr_size);
-	for (int exp = 1; max / exp > 0; exp *= 10)
-		counting_sort_digit(arr, arr_size, exp);
-}
-
-
 /// <summary>
 /// Sorts array using counting sort on given digit, given by exp (exp=1 -> 1st digit, exp=10 -> 2nd digit etc...)
 /// This is used as sub routine for int sorting radix sort
@@ -45,4 +34,14 @@ void counting_sort_digit(T* arr, const size_t& arr_size, const int& exp) {
 	//delete garbage
 	delete[] counting_arr;
 	delete[] out;
+}
+
+/// <summary>
+/// Sorts array of integers using radix sort. Please note that this algorithm cannot sort properly floating point numbers
+/// </summary>
+template<class T = int>
+void radix_sort_int(T* arr, const size_t& arr_size) {
+	T max = *std::max_element(arr, arr + arr_size);
+	for (int exp = 1; max / exp > 0; exp *= 10)
+		counting_sort_digit(arr, arr_size, exp);
 }
\ No newline at end of file
@@ -28,7 +28,7 @@ inline void merge(T* arr, const int& p, const int& q, const int& r, Comp compare
 	//As long as Left or Right contains unmerged elements, copy the smallest element into A[p,r]
 	while (i < nl && j < nr)
 	{
-		if (compare_function(Left[i], Right[j]))
+		if (!compare_function(Right[j], Left[i])) //take from the left on equal elements, this keeps the sort stable
 			arr[k++] = Left[i++];
 		else
 			arr[k++] = Right[j++];
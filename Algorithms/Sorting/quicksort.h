@@ -42,8 +42,8 @@ std::pair<size_t, size_t> double_partition(T* arr, const size_t& p, const size_t
 
 		else if (comp(arr[j], pivot))//if the element belongs to lowside - swap it
 		{
-			std::swap(arr[i++], arr[j]);//this basically moves [i:ie] by 1 position to right
-			std::swap(arr[ie++], arr[j]);
+			std::swap(arr[ie++], arr[j]);//move it to the end of the equal side first, so it also works when there are no equal elements yet
+			std::swap(arr[i++], arr[ie - 1]);//this basically moves [i:ie] by 1 position to right
 		}
 	}
 
@@ -93,7 +93,7 @@ size_t random_partition(T* arr, const size_t& p, const size_t& r, Comparator com
 {
 	size_t i = StaticRandom::NextLong(p, r + 1);
 	std::swap(arr[r], arr[i]);//change pivot to random one
-	return partition(arr, p, r);
+	return partition(arr, p, r, comp);
 }
 
 /// <summary>
@@ -111,7 +111,7 @@ size_t random_median_partition(T* arr, const size_t& p, const size_t& r, Compara
 	size_t i = StaticRandom::NextLong(p, r - 2);
 	T& median = std::max(std::min(arr[i], arr[i+1]), std::min(std::max(arr[i], arr[i+1]), arr[i+2]));
 	std::swap(arr[r], median);
-	return partition(arr, p, r);
+	return partition(arr, p, r, comp);
 }
 
 template<class T, class Comparator = std::less<T>>
@@ -25,12 +25,42 @@ int main()
 }
 
 
+//TEST HARNESS (include Algorithms/Sorting/Tests/test_sorts.h, test_order_statistics.h, test_quantile_sketch.h, test_min_max.h, test_top_k.h, Algorithms/Searching/Tests/test_search.h, Data Structures/Tests/test_heaps.h, Algorithms/Random/Tests/test_random.h, test_shuffle.h, test_sampling.h, test_counters.h and test_sketches.h)
+/*
+    bool ok = test_sorts_differential();
+    ok &= test_select_differential();
+    ok &= test_multi_select_differential();
+    ok &= test_parallel_select_differential();
+    ok &= test_quantile_sketch();
+    ok &= test_min_max_differential();
+    ok &= test_top_k_differential();
+    ok &= test_search_differential();
+    ok &= test_linear_search_differential();
+    ok &= test_heap_differential();
+    ok &= test_indexed_heap_differential();
+    ok &= test_multi_queue();
+    ok &= test_mergeable_heaps();
+    ok &= test_random_engines();
+    ok &= test_random_bulk();
+    ok &= test_random_streams();
+    ok &= test_shuffle();
+    ok &= test_sampling();
+    ok &= test_counters();
+    ok &= test_hyperloglog();
+    ok &= test_frequency_sketches();
+
+    PerformanceBaseline baseline("perf_baseline.txt"); //delete the file to record new baselines
+    ok &= test_sorts_performance(baseline);
+    ok &= test_select_performance(baseline);
+    return ok ? 0 : 1;
+*/
+
 //TEST HEAP, YOUNG TABLEAU
 /*
 *   int arr[] = { 6,4,5,20,3,15,25,100};
     std::cout << "Array:\n";
     print_array(arr, ARR_SIZE(arr));
-    D_AryHeap<int,3>::array_heapify(arr, ARR_SIZE(arr),3);
+    D_AryHeap<int,3>::array_heapify(arr, ARR_SIZE(arr));
     //Heap<int>::array_heapify(arr, ARR_SIZE(arr));
     std::cout << "After using heap: \n";
     print_array(arr, ARR_SIZE(arr));
@@ -1,41 +1,45 @@
 #pragma once
 #include <functional>
+#include <stdexcept>
+#include <utility>
+#include "Data Structures/heap_storage.h"
 
 /// <summary>
 /// Heap implementation, has static methods to create heaps from arrays
 /// This heap can be effectively used as priority queue
 /// By default this is min-heap, change comparator to make it max-heap
+/// Items are moved, not copied, when heap grows and when they are pushed as rvalues, emplaced or taken by pop_top
 /// </summary>
 /// <typeparam name="Comparator">Comparator that will be used, change to std::greater to get max-heap</typeparam>
 template<class T, class Comparator = std::less<T>>
 class Heap
 {
 private:
-	T* arr = nullptr;
-	size_t size = 0;
-	size_t capacity = 1;
+	HeapStorage<T> storage;
 
 	static size_t parent(const size_t& node) { return node >> 1; }
 	static size_t left(const size_t& node)   { return  node << 1; }
 	static size_t right(const size_t& node)  { return (node << 1) + 1; }
 
-
-	T* get_array_copy(); //helper function to create a copy of array in heap
-	void copy_array(T* arr, const size_t& size);//copies arr into heap arr, assumes that arr is already heap
-	void delete_array();//deletes array
-
-	void build_heap(T* arr, const size_t& size, Comparator comp = Comparator()); //build heap from array
-	bool IsOk() { return size >= 0 && arr != nullptr; }//helper function that returns false if heap is not usable
-	void resize();
+	void build_heap(const T* arr, const size_t& size, Comparator comp = Comparator()); //build heap from array
+	void sift_up(size_t node, Comparator comp = Comparator()); //moves item at node up until its parent is not after it
 public:
 	Heap(){}
-	Heap(const size_t& _capacity) : capacity(_capacity) {}
-	Heap(T* arr, const size_t& arr_size) { build_heap(arr, arr_size); }
-	Heap(const Heap& other);
-	~Heap() { delete_array(); }
+	Heap(const size_t& _capacity) { storage.reserve(_capacity); }
+	Heap(const T* arr, const size_t& arr_size) { build_heap(arr, arr_size); }
 
-	size_t get_size() { return size; }
-	size_t get_capacity() { return capacity; }
+	size_t get_size() { return storage.size(); }
+	size_t get_capacity() { return storage.capacity(); }
+	bool empty() { return storage.empty(); }
+
+	/// <summary>
+	/// Makes room for at least capacity items, so pushes up to capacity do not reallocate
+	/// </summary>
+	void reserve(const size_t& capacity) { storage.reserve(capacity); }
+	/// <summary>
+	/// Frees memory that is not used by items of heap
+	/// </summary>
+	void shrink_to_fit() { storage.shrink_to_fit(); }
 
 	/// <summary>
 	/// pops the last element
@@ -49,6 +53,10 @@ public:
 	/// Gets the top element and deletes it, returns default value if top does not exist
 	/// </summary>
 	T remove_top();
+	/// <summary>
+	/// Moves the top element out of heap and deletes it, throws std::out_of_range if heap is empty
+	/// </summary>
+	T pop_top(Comparator comp = Comparator());
 
 	/// <summary>
 	/// Removes given element from heap, if not found nothing happens
@@ -73,7 +81,20 @@ public:
 	/// <summary>
 	/// Inserts value into heap
 	/// </summary>
-	void insert(const T& val, Comparator comp = Comparator());
+	void insert(const T& val, Comparator comp = Comparator()) { push(val, comp); }
+	/// <summary>
+	/// Inserts copy of value into heap
+	/// </summary>
+	void push(const T& val, Comparator comp = Comparator());
+	/// <summary>
+	/// Moves value into heap
+	/// </summary>
+	void push(T&& val, Comparator comp = Comparator());
+	/// <summary>
+	/// Constructs value from arguments in place in heap
+	/// </summary>
+	template<class... Args>
+	void emplace(Args&&... args);
 
 	/// <summary>
 	/// Inserts array of values into heap
@@ -123,11 +144,9 @@ void Heap<T, Comparator>::heapify(T* arr,const size_t& arr_size,const size_t& no
 template<class T, class Comparator>
 inline void Heap<T, Comparator>::insert_arr(const T* arr, const size_t& arr_size, Comparator comp)
 {
-	if (!IsOk())
-		return;
-
+	storage.reserve(storage.size() + arr_size);
 	for (size_t x = 0; x < arr_size; x++)
-		insert(arr[x], comp);
+		push(arr[x], comp);
 }
 
 template<class T, class Comparator>
@@ -139,131 +158,92 @@ void Heap<T, Comparator>::array_heapify(T* arr, const size_t& size, Comparator c
 }
 
 template<class T, class Comparator>
-inline T* Heap<T, Comparator>::get_array_copy()
-{
-	T* out = new T[size];
-	for (int x = 0; x < size; x++)
-		out[x] = arr[x];
-	return out;
-}
-
-template<class T, class Comparator>
-inline void Heap<T, Comparator>::copy_array(T* arr, const size_t& size)
-{
-	//delete previous array if existed
-	delete_array();
-	this->arr = new T[size];
-	this->capacity = size;
-	this->size = size;
-
-	for (int x = 0; x < size; x++)
-		this->arr[x] = arr[x];
-}
-
-template<class T, class Comparator>
-inline void Heap<T, Comparator>::delete_array()
-{
-	if (arr == nullptr)
-		return;
-
-	delete[] arr;
-	size = 0;
-	arr = nullptr;
-}
-
-template<class T, class Comparator>
-inline void Heap<T, Comparator>::build_heap(T* arr, const size_t& size, Comparator comp)
+inline void Heap<T, Comparator>::build_heap(const T* arr, const size_t& size, Comparator comp)
 {
-	delete_array();
-	copy_array(arr, size);
-
-	for (size_t x = size >> 1; x > 0; x--)
-		heapify(this->arr,this->size,x, comp);
-}
-
-template<class T, class Comparator>
-inline void Heap<T, Comparator>::resize()
-{
-	capacity *= 2;
-	T* arr = get_array_copy();
-	size_t old_size = size;
-	delete_array();
-
-	this->size = old_size;
-	this->arr = new T[capacity];
-
+	storage.clear();
+	storage.reserve(size);
 	for (size_t x = 0; x < size; x++)
-		this->arr[x] = arr[x];
+		storage.emplace_back(arr[x]);
 
-	delete[] arr;
+	array_heapify(storage.data(), storage.size(), comp);
 }
 
 template<class T, class Comparator>
-inline Heap<T, Comparator>::Heap(const Heap& other)
+inline void Heap<T, Comparator>::sift_up(size_t node, Comparator comp)
 {
-	//array in other heap is already heapified, so we need only to make a copy
-	arr = new T[other.capacity];
-	for (size_t x = 0; x < other.size; x++)
-		arr[x] = other.arr[x];
-
-	size = other.size;
-	capacity = other.capacity;
+	//hole is moved up and item is moved once into its place, instead of swap on every level
+	T item = std::move(storage[node]);
+	while (node > 0 && comp(item, storage[parent(node)]))
+	{
+		storage[node] = std::move(storage[parent(node)]);
+		node = parent(node);
+	}
+	storage[node] = std::move(item);
 }
 
 template<class T, class Comparator>
 inline void Heap<T, Comparator>::pop()
 {
-	if (!IsOk())
+	if (storage.empty())
 		return;
-	size--;
+	storage.pop_back();
 }
 
 template<class T, class Comparator>
 inline T Heap<T, Comparator>::top()
 {
-	if(!IsOk())
+	if (storage.empty())
 		return T();
-	return arr[0];
+	return storage[0];
 }
 
 template<class T, class Comparator>
 inline T Heap<T, Comparator>::remove_top()
 {
-	if(!IsOk())
+	if (storage.empty())
 		return T();
+	return pop_top();
+}
 
-	T top = top();
-	std::swap(arr[0], arr[size - 1]); //swap top with last element, then pop it
-	pop();
-	heapify(arr, size, 0);
+template<class T, class Comparator>
+inline T Heap<T, Comparator>::pop_top(Comparator comp)
+{
+	if (storage.empty()) throw std::out_of_range("Heap is empty");
+
+	T top = std::move(storage[0]);
+	const size_t last = storage.size() - 1;
+	if (last > 0) //last element takes place of top, then it is heapified
+		storage[0] = std::move(storage[last]);
+	storage.pop_back();
+	heapify(storage.data(), storage.size(), 0, comp);
 	return top;
 }
 
 template<class T, class Comparator>
 inline void Heap<T, Comparator>::remove(const T& val)
 {
-	if (!IsOk())
-		return;
-
-	size_t i = find(val);
+	const long long i = find(val);
 	if (i < 0) //not found
 		return;
 
-	std::swap(arr[i], arr[size - 1]);
-	pop();
-	heapify(arr, size, i);
+	const size_t last = storage.size() - 1;
+	if ((size_t)i != last)
+		storage[i] = std::move(storage[last]);
+	storage.pop_back();
+	if ((size_t)i < storage.size()) //last element can belong below or above the place of removed one
+	{
+		heapify(storage.data(), storage.size(), i);
+		sift_up(i);
+	}
 }
 
 template<class T, class Comparator>
 inline long long Heap<T, Comparator>::find(const T& val, Comparator comp)
 {
-	if (!IsOk())
-		return -1;
-
 	//simple linear search
-	for (long long x = 0; x < size; x++)
-		if (arr[x] == val)
-			return x;
+	for (size_t x = 0; x < storage.size(); x++)
+		if (storage[x] == val)
+			return (long long)x;
 
 	return -1;
 }
@@ -271,45 +251,39 @@ inline long long Heap<T, Comparator>::find(const T& val, Comparator comp)
 template<class T, class Comparator>
 inline bool Heap<T, Comparator>::exists(const T& val)
 {
-	if (!IsOk())
-		return false;
-
-	return Find(val) >= 0;
+	return find(val) >= 0;
 }
 
 template<class T, class Comparator>
 inline void Heap<T, Comparator>::change_value(const T& val, const T& new_val, Comparator comp)
 {
-	size_t i = Find(val);
+	const long long i = find(val);
 	if (i < 0)
 		return;
 
-	arr[i] = new_val;
-
-	while (i > 0 && !comp(arr[parent(i)], arr[i]))
-	{
-		std::swap(arr[i], arr[parent(i)]);
-		i = parent(i);
-	}
+	storage[i] = new_val;
+	heapify(storage.data(), storage.size(), i, comp);
+	sift_up(i, comp);
 }
 
 template<class T, class Comparator>
-inline void Heap<T, Comparator>::insert(const T& val, Comparator comp)
+inline void Heap<T, Comparator>::push(const T& val, Comparator comp)
 {
-	if (!IsOk())
-		return;
-
-	if (size == capacity)
-		resize();
+	storage.emplace_back(val);
+	sift_up(storage.size() - 1, comp);
+}
 
-	size++;
-	size_t i = size-1;
-	arr[i] = val;
+template<class T, class Comparator>
+inline void Heap<T, Comparator>::push(T&& val, Comparator comp)
+{
+	storage.emplace_back(std::move(val));
+	sift_up(storage.size() - 1, comp);
+}
 
-	//same as change value
-	while (i > 0 && !comp(arr[parent(i)], arr[i]))
-	{
-		std::swap(arr[i], arr[parent(i)]);
-		i = parent(i);
-	}
+template<class T, class Comparator>
+template<class... Args>
+inline void Heap<T, Comparator>::emplace(Args&&... args)
+{
+	storage.emplace_back(std::forward<Args>(args)...);
+	sift_up(storage.size() - 1);
 }
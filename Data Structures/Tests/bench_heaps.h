@@ -0,0 +1,432 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <queue>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <utility>
+#include <cstdint>
+#include "Utility/benchmark.h"
+#include "Utility/simd.h"
+#include "Data Structures/Heap.h"
+#include "Data Structures/d-aryheap.h"
+#include "Data Structures/indexed_heap.h"
+#include "Data Structures/multi_queue.h"
+#include "Data Structures/pairing_heap.h"
+#include "Data Structures/radix_heap.h"
+
+//push and pop of benchmarked heaps, std::priority_queue keeps the greatest item on top, so it is given reversed comparator
+template<class T, class Container, class Comparator>
+void heap_bench_push(std::priority_queue<T, Container, Comparator>& heap, const T& item) { heap.push(item); }
+
+template<class T, class Container, class Comparator>
+T heap_bench_pop(std::priority_queue<T, Container, Comparator>& heap)
+{
+	T top = heap.top();
+	heap.pop();
+	return top;
+}
+
+template<class HeapType, class T>
+void heap_bench_push(HeapType& heap, const T& item) { heap.push(item); }
+
+template<class HeapType>
+auto heap_bench_pop(HeapType& heap) -> decltype(heap.pop_top()) { return heap.pop_top(); }
+
+/// <summary>
+/// Measures heap of type HeapType on keys: pushes all keys and pops them (push, pop),
+/// and hold model, where heap of all keys pops its top and pushes it back increased by key (as in simulations and Dijkstra)
+/// Results are printed in millions of operations per second
+/// </summary>
+template<class HeapType, class T, class Increase>
+void bench_heap_type(const std::string& name, const std::vector<T>& keys, Increase increase)
+{
+	volatile size_t sink = 0;
+	const size_t size = keys.size();
+	print_throughput(name + " push", measure_throughput([&]() {
+		HeapType heap;
+		for (const T& key : keys)
+			heap_bench_push(heap, key);
+		sink = sizeof(heap);
+	}, size, 3), "ops/s");
+
+	HeapType filled, heap;
+	for (const T& key : keys)
+		heap_bench_push(filled, key);
+	print_throughput(name + " pop", measure_throughput([&]() { heap = filled; }, [&]() {
+		for (size_t x = 0; x < size; x++)
+			heap_bench_pop(heap);
+		sink = heap.empty();
+	}, size, 3), "ops/s");
+
+	print_throughput(name + " hold (pop + push)", measure_throughput([&]() { heap = filled; }, [&]() {
+		for (size_t x = 0; x < size; x++)
+			heap_bench_push(heap, increase(heap_bench_pop(heap), keys[x]));
+		sink = heap.empty();
+	}, size, 3), "ops/s");
+}
+
+//item of 16 bytes ordered by key, as priority and payload of task queues
+struct HeapBenchItem
+{
+	long long key = 0;
+	long long value = 0;
+	bool operator<(const HeapBenchItem& other) const { return key < other.key; }
+	bool operator>(const HeapBenchItem& other) const { return other.key < key; }
+};
+
+/// <summary>
+/// Compares min-heaps of size random ints: std::priority_queue, Heap, and D_AryHeap with bases 2, 4, 8 and 16 (with SIMD and without it),
+/// then of 16 byte items: std::priority_queue, Heap, and D_AryHeap with bases 2 and 4 (4 children fill cache line)
+/// Results are printed in millions of operations per second
+/// </summary>
+inline void bench_heaps(const size_t& size = size_t(1) << 20, const uint64_t& seed = 20240601)
+{
+	std::mt19937_64 gen(seed);
+	std::vector<int> keys(size);
+	std::uniform_int_distribution<int> dist(0, 1 << 20);
+	for (auto& key : keys)
+		key = dist(gen);
+	auto increase = [](const int& top, const int& key) { return top + key; };
+
+	std::cout << "Min-heap of " << size << " ints:\n";
+	bench_heap_type<std::priority_queue<int, std::vector<int>, std::greater<int>>>("std::priority_queue", keys, increase);
+	bench_heap_type<Heap<int>>("Heap", keys, increase);
+	bench_heap_type<D_AryHeap<int, 2>>("D_AryHeap<2>", keys, increase);
+	bench_heap_type<D_AryHeap<int, 4>>("D_AryHeap<4>", keys, increase);
+	bench_heap_type<D_AryHeap<int, 8>>("D_AryHeap<8>", keys, increase);
+	bench_heap_type<D_AryHeap<int, 16>>("D_AryHeap<16>", keys, increase);
+	simd_limit_level(SimdLevel::Scalar);
+	bench_heap_type<D_AryHeap<int, 8>>("D_AryHeap<8> scalar", keys, increase);
+	bench_heap_type<D_AryHeap<int, 16>>("D_AryHeap<16> scalar", keys, increase);
+	simd_limit_level(simd_detect_level());
+
+	std::vector<HeapBenchItem> items(size);
+	for (size_t x = 0; x < size; x++)
+		items[x].key = items[x].value = keys[x];
+	auto increase_item = [](const HeapBenchItem& top, const HeapBenchItem& item) {
+		HeapBenchItem out = top;
+		out.key += item.key;
+		return out;
+	};
+	std::cout << "Min-heap of " << size << " 16 byte items:\n";
+	bench_heap_type<std::priority_queue<HeapBenchItem, std::vector<HeapBenchItem>, std::greater<HeapBenchItem>>>("std::priority_queue", items, increase_item);
+	bench_heap_type<Heap<HeapBenchItem>>("Heap", items, increase_item);
+	bench_heap_type<D_AryHeap<HeapBenchItem, 2>>("D_AryHeap<2>", items, increase_item);
+	bench_heap_type<D_AryHeap<HeapBenchItem, d_ary_cache_arity<HeapBenchItem>::value>>("D_AryHeap<4>", items, increase_item);
+}
+
+/// <summary>
+/// Measures merging of shards into one heap of type HeapType: shards are made by make_shard from shard_items (not measured),
+/// then meld(heap, shard) moves every shard into heap (meld), and in the second run heap pops all items after that (meld + pop)
+/// Results are printed in millions of items per second
+/// </summary>
+template<class HeapType, class ShardType, class MakeShard, class Meld>
+void bench_meld_type(const std::string& name, const std::vector<std::vector<unsigned int>>& shard_items, MakeShard make_shard, Meld meld)
+{
+	volatile size_t sink = 0;
+	size_t size = 0;
+	for (const auto& items : shard_items)
+		size += items.size();
+
+	std::vector<ShardType> shards;
+	HeapType heap;
+	auto setup = [&]() {
+		shards.clear();
+		for (const auto& items : shard_items)
+			shards.push_back(make_shard(items));
+		heap = HeapType();
+	};
+	print_throughput(name + " meld", measure_throughput(setup, [&]() {
+		for (ShardType& shard : shards)
+			meld(heap, shard);
+		sink = heap.empty();
+	}, size, 3), "items/s");
+	print_throughput(name + " meld + pop", measure_throughput(setup, [&]() {
+		for (ShardType& shard : shards)
+			meld(heap, shard);
+		while (!heap.empty())
+			heap_bench_pop(heap);
+		sink = heap.empty();
+	}, size, 3), "items/s");
+}
+
+/// <summary>
+/// Compares merging of shard_count shards of shard_size random keys into one min-heap (as queues of worker threads):
+/// std::priority_queue and D_AryHeap<4> push every item, Heap inserts items of shard by insert_arr,
+/// PairingHeap and RadixHeap meld whole shard heaps. Results are printed in millions of items per second
+/// </summary>
+inline void bench_meld(const size_t& shard_count = 1024, const size_t& shard_size = 1024, const uint64_t& seed = 20240601)
+{
+	std::mt19937_64 gen(seed);
+	std::vector<std::vector<unsigned int>> shard_items(shard_count, std::vector<unsigned int>(shard_size));
+	for (auto& items : shard_items)
+		for (auto& key : items)
+			key = (unsigned int)(gen() % (1 << 20));
+
+	typedef std::vector<unsigned int> Items;
+	auto copy = [](const Items& items) { return items; };
+	auto push_all = [](auto& heap, const Items& items) {
+		for (const unsigned int& key : items)
+			heap_bench_push(heap, key);
+	};
+
+	std::cout << "Meld of " << shard_count << " shards of " << shard_size << " ints:\n";
+	bench_meld_type<std::priority_queue<unsigned int, Items, std::greater<unsigned int>>, Items>("std::priority_queue (push)", shard_items, copy, push_all);
+	bench_meld_type<D_AryHeap<unsigned int, 4>, Items>("D_AryHeap<4> (push)", shard_items, copy, push_all);
+	bench_meld_type<Heap<unsigned int>, Items>("Heap (insert_arr)", shard_items, copy,
+		[](Heap<unsigned int>& heap, const Items& items) { heap.insert_arr(items.data(), items.size()); });
+	bench_meld_type<PairingHeap<unsigned int>, PairingHeap<unsigned int>>("PairingHeap (meld)", shard_items, [](const Items& items) {
+		PairingHeap<unsigned int> shard;
+		for (const unsigned int& key : items)
+			shard.push(key);
+		return shard;
+	}, [](PairingHeap<unsigned int>& heap, PairingHeap<unsigned int>& shard) { heap.meld(shard); });
+	bench_meld_type<RadixHeap<unsigned int>, RadixHeap<unsigned int>>("RadixHeap (meld)", shard_items, [](const Items& items) {
+		RadixHeap<unsigned int> shard;
+		for (const unsigned int& key : items)
+			shard.push(key);
+		return shard;
+	}, [](RadixHeap<unsigned int>& heap, RadixHeap<unsigned int>& shard) { heap.meld(shard); });
+}
+
+/// <summary>
+/// Directed graph in compressed rows, edges of vertex v are [offsets[v], offsets[v + 1])
+/// </summary>
+struct HeapBenchGraph
+{
+	size_t vertex_count = 0;
+	std::vector<size_t> offsets;
+	std::vector<uint32_t> targets;
+	std::vector<uint32_t> weights;
+};
+
+//random graph with degree edges of random weights from every vertex, edge to the next vertex keeps every vertex reachable
+inline HeapBenchGraph make_heap_bench_graph(const size_t& vertex_count, const size_t& degree, const uint64_t& seed)
+{
+	std::mt19937_64 gen(seed);
+	std::uniform_int_distribution<uint32_t> vertex(0, (uint32_t)vertex_count - 1), weight(1, 1000);
+	HeapBenchGraph graph;
+	graph.vertex_count = vertex_count;
+	graph.offsets.resize(vertex_count + 1);
+	graph.targets.reserve(vertex_count * degree);
+	graph.weights.reserve(vertex_count * degree);
+	for (size_t v = 0; v < vertex_count; v++)
+	{
+		graph.offsets[v] = graph.targets.size();
+		graph.targets.push_back((uint32_t)((v + 1) % vertex_count));
+		graph.weights.push_back(weight(gen) * 100);
+		for (size_t e = 1; e < degree; e++)
+		{
+			graph.targets.push_back(vertex(gen));
+			graph.weights.push_back(weight(gen));
+		}
+	}
+	graph.offsets[vertex_count] = graph.targets.size();
+	return graph;
+}
+
+/// <summary>
+/// Dijkstra's algorithm with addressable heap, vertex is handle and shorter path decreases its key
+/// </summary>
+template<class HeapType>
+std::vector<uint64_t> dijkstra_decrease_key(const HeapBenchGraph& graph, const uint32_t& source)
+{
+	std::vector<uint64_t> distance(graph.vertex_count, UINT64_MAX);
+	HeapType heap(graph.vertex_count);
+	distance[source] = 0;
+	heap.push(source, 0);
+	while (!heap.empty())
+	{
+		const std::pair<size_t, uint64_t> top = heap.pop_top();
+		for (size_t e = graph.offsets[top.first]; e < graph.offsets[top.first + 1]; e++)
+		{
+			const uint32_t target = graph.targets[e];
+			const uint64_t length = top.second + graph.weights[e];
+			if (length < distance[target])
+			{
+				distance[target] = length;
+				heap.push_or_change(target, length);
+			}
+		}
+	}
+	return distance;
+}
+
+/// <summary>
+/// Dijkstra's algorithm with heap of (distance, vertex) pairs, shorter path pushes new pair and stale pairs are skipped when popped
+/// </summary>
+template<class HeapType>
+std::vector<uint64_t> dijkstra_lazy(const HeapBenchGraph& graph, const uint32_t& source)
+{
+	std::vector<uint64_t> distance(graph.vertex_count, UINT64_MAX);
+	HeapType heap;
+	distance[source] = 0;
+	heap_bench_push(heap, std::make_pair((uint64_t)0, source));
+	while (!heap.empty())
+	{
+		const std::pair<uint64_t, uint32_t> top = heap_bench_pop(heap);
+		if (top.first > distance[top.second])
+			continue;
+		for (size_t e = graph.offsets[top.second]; e < graph.offsets[top.second + 1]; e++)
+		{
+			const uint32_t target = graph.targets[e];
+			const uint64_t length = top.first + graph.weights[e];
+			if (length < distance[target])
+			{
+				distance[target] = length;
+				heap_bench_push(heap, std::make_pair(length, target));
+			}
+		}
+	}
+	return distance;
+}
+
+/// <summary>
+/// Dijkstra's algorithm with PairingHeap of (distance, vertex) pairs, handle of every queued vertex decreases its pair
+/// </summary>
+template<class HeapType>
+std::vector<uint64_t> dijkstra_handles(const HeapBenchGraph& graph, const uint32_t& source)
+{
+	std::vector<uint64_t> distance(graph.vertex_count, UINT64_MAX);
+	std::vector<typename HeapType::Handle> handles(graph.vertex_count);
+	std::vector<bool> queued(graph.vertex_count, false);
+	HeapType heap;
+	distance[source] = 0;
+	handles[source] = heap.push(std::make_pair((uint64_t)0, source));
+	queued[source] = true;
+	while (!heap.empty())
+	{
+		const std::pair<uint64_t, uint32_t> top = heap.pop_top();
+		queued[top.second] = false;
+		for (size_t e = graph.offsets[top.second]; e < graph.offsets[top.second + 1]; e++)
+		{
+			const uint32_t target = graph.targets[e];
+			const uint64_t length = top.first + graph.weights[e];
+			if (length < distance[target])
+			{
+				distance[target] = length;
+				if (queued[target])
+					heap.decrease_key(handles[target], std::make_pair(length, target));
+				else
+				{
+					handles[target] = heap.push(std::make_pair(length, target));
+					queued[target] = true;
+				}
+			}
+		}
+	}
+	return distance;
+}
+
+/// <summary>
+/// Compares shortest paths from one vertex of random graph with vertex_count vertices and degree edges per vertex:
+/// lazy deletion with std::priority_queue, D_AryHeap<4>, PairingHeap and RadixHeap, and decrease-key with IndexedHeap of bases 2, 4 and 8
+/// and PairingHeap
+/// Every result is checked against the first one, results are printed in millions of edges per second
+/// </summary>
+inline void bench_dijkstra(const size_t& vertex_count = size_t(1) << 20, const size_t& degree = 8, const uint64_t& seed = 20240601)
+{
+	const HeapBenchGraph graph = make_heap_bench_graph(vertex_count, degree, seed);
+	typedef std::pair<uint64_t, uint32_t> Item;
+	std::vector<uint64_t> expected, distance;
+	auto run = [&](const std::string& name, std::function<std::vector<uint64_t>()> dijkstra) {
+		print_throughput(name, measure_throughput([&]() { distance = dijkstra(); }, graph.targets.size(), 3), "edges/s");
+		if (expected.empty())
+			expected = distance;
+		else if (distance != expected)
+			std::cout << "  [FAIL] " << name << " distances differ\n";
+	};
+
+	std::cout << "Dijkstra on " << vertex_count << " vertices, " << graph.targets.size() << " edges:\n";
+	run("std::priority_queue (lazy deletion)", [&]() { return dijkstra_lazy<std::priority_queue<Item, std::vector<Item>, std::greater<Item>>>(graph, 0); });
+	run("D_AryHeap<4> (lazy deletion)", [&]() { return dijkstra_lazy<D_AryHeap<Item, 4>>(graph, 0); });
+	run("PairingHeap (lazy deletion)", [&]() { return dijkstra_lazy<PairingHeap<Item>>(graph, 0); });
+	run("RadixHeap (lazy deletion)", [&]() { return dijkstra_lazy<RadixHeap<Item, RadixHeapFirst>>(graph, 0); });
+	run("IndexedHeap<2> (decrease key)", [&]() { return dijkstra_decrease_key<IndexedHeap<uint64_t, 2>>(graph, 0); });
+	run("IndexedHeap<4> (decrease key)", [&]() { return dijkstra_decrease_key<IndexedHeap<uint64_t, 4>>(graph, 0); });
+	run("IndexedHeap<8> (decrease key)", [&]() { return dijkstra_decrease_key<IndexedHeap<uint64_t, 8>>(graph, 0); });
+	run("PairingHeap (decrease key)", [&]() { return dijkstra_handles<PairingHeap<Item>>(graph, 0); });
+}
+
+//Heap shared by threads behind one mutex, baseline of concurrent queues
+template<class T>
+class HeapBenchLockedHeap
+{
+private:
+	Heap<T> heap;
+	std::mutex mutex;
+public:
+	HeapBenchLockedHeap(unsigned int) {}
+	void push(T item)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		heap.push(std::move(item));
+	}
+	bool try_pop(T& out)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (heap.empty())
+			return false;
+		out = heap.pop_top();
+		return true;
+	}
+};
+
+//MultiQueue with 4 shards per thread, constructed from thread count as other benchmarked queues
+template<class T>
+class HeapBenchMultiQueue4 : public MultiQueue<T>
+{
+public:
+	HeapBenchMultiQueue4(unsigned int thread_count) : MultiQueue<T>(thread_count, 4) {}
+};
+
+/// <summary>
+/// Runs hold model on concurrent queue from thread_count threads: queue is filled with size items, then every thread
+/// pops an item and pushes it back increased by random number, operations times. Returns pops and pushes per second
+/// </summary>
+template<class Queue>
+double bench_concurrent_queue(const unsigned int& thread_count, const size_t& size, const size_t& operations, const uint64_t& seed)
+{
+	std::unique_ptr<Queue> queue;
+	return measure_throughput([&]() {
+		queue.reset(new Queue(thread_count));
+		std::mt19937_64 gen(seed);
+		for (size_t x = 0; x < size; x++)
+			queue->push((int)(gen() % (1 << 20)));
+	}, [&]() {
+		std::vector<std::thread> threads;
+		for (unsigned int t = 0; t < thread_count; t++)
+			threads.emplace_back([&, t]() {
+				std::mt19937_64 gen(seed + t);
+				int item = 0;
+				for (size_t x = t; x < operations; x += thread_count)
+					if (queue->try_pop(item))
+						queue->push(item + (int)(gen() % 1024));
+			});
+		for (auto& thread : threads)
+			thread.join();
+	}, 2 * operations, 3);
+}
+
+/// <summary>
+/// Compares concurrent priority queues of ints in hold model (see bench_concurrent_queue) for 1, 2, 4, ... up to max_threads threads:
+/// Heap behind std::mutex, and MultiQueue with 2 and 4 D_AryHeap shards per thread
+/// Results are printed in millions of operations (pops and pushes) per second
+/// </summary>
+inline void bench_multi_queue(unsigned int max_threads = 0, const size_t& size = size_t(1) << 20, const size_t& operations = size_t(1) << 22, const uint64_t& seed = 20240601)
+{
+	if (max_threads == 0)
+		max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+	for (unsigned int thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+	{
+		std::cout << "Concurrent queue of " << size << " ints, threads=" << thread_count << ":\n";
+		print_throughput("Heap + std::mutex", bench_concurrent_queue<HeapBenchLockedHeap<int>>(thread_count, size, operations, seed), "ops/s");
+		print_throughput("MultiQueue (2 shards per thread)", bench_concurrent_queue<MultiQueue<int>>(thread_count, size, operations, seed), "ops/s");
+		print_throughput("MultiQueue (4 shards per thread)", bench_concurrent_queue<HeapBenchMultiQueue4<int>>(thread_count, size, operations, seed), "ops/s");
+	}
+}
@@ -0,0 +1,620 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <set>
+#include <limits>
+#include <cmath>
+#include <thread>
+#include "Utility/testing.h"
+#include "Utility/simd.h"
+#include "Data Structures/Heap.h"
+#include "Data Structures/d-aryheap.h"
+#include "Data Structures/indexed_heap.h"
+#include "Data Structures/multi_queue.h"
+#include "Data Structures/pairing_heap.h"
+#include "Data Structures/radix_heap.h"
+
+/// <summary>
+/// Checks heap built from arr and filled by pushes against sorted copy of arr, and random pushes and pops against std::priority_queue
+/// Heap has to pop items in order of Comparator
+/// </summary>
+template<class HeapType, class Comparator>
+void check_heap(TestReport& report, const std::vector<int>& arr, std::mt19937_64& gen, const std::string& name)
+{
+	std::vector<int> expected = arr;
+	std::sort(expected.begin(), expected.end(), Comparator());
+
+	HeapType built(arr.data(), arr.size());
+	std::vector<int> popped;
+	while (!built.empty())
+		popped.push_back(built.pop_top());
+	report.check(popped == expected, name + " built from array");
+
+	HeapType pushed;
+	for (const int& item : arr)
+		pushed.push(item);
+	report.check(pushed.get_size() == arr.size(), name + " size after push");
+	popped.clear();
+	while (!pushed.empty())
+		popped.push_back(pushed.remove_top());
+	report.check(popped == expected, name + " filled by push");
+
+	//std::priority_queue pops the greatest item first, so its comparator is reversed
+	auto reversed = [](const int& a, const int& b) { return Comparator()(b, a); };
+	std::priority_queue<int, std::vector<int>, decltype(reversed)> queue(reversed);
+	HeapType mixed;
+	bool same = true;
+	for (const int& item : arr)
+	{
+		if (gen() % 3 == 0 && !queue.empty())
+		{
+			same &= mixed.top() == queue.top() && mixed.pop_top() == queue.top();
+			queue.pop();
+		}
+		int value = item;
+		mixed.push(std::move(value));
+		queue.push(item);
+	}
+	while (!queue.empty())
+	{
+		same &= mixed.pop_top() == queue.top();
+		queue.pop();
+	}
+	report.check(same && mixed.empty(), name + " mixed with pops");
+
+	//removed and changed values, remaining items still pop in order
+	if (arr.size() > 2)
+	{
+		HeapType changed(arr.data(), arr.size());
+		expected = arr;
+		const int removed = arr[gen() % arr.size()], old_value = arr[gen() % arr.size()], new_value = (int)(gen() % 1000000);
+		changed.remove(removed);
+		expected.erase(std::find(expected.begin(), expected.end(), removed));
+		if (changed.exists(old_value))
+		{
+			changed.change_value(old_value, new_value);
+			*std::find(expected.begin(), expected.end(), old_value) = new_value;
+		}
+		std::sort(expected.begin(), expected.end(), Comparator());
+		popped.clear();
+		while (!changed.empty())
+			popped.push_back(changed.pop_top());
+		report.check(popped == expected, name + " remove and change_value");
+	}
+}
+
+//counts copies and moves of items, so test can check that heap moves them
+struct HeapTracked
+{
+	static size_t& copies()
+	{
+		static size_t count = 0;
+		return count;
+	}
+	int key = 0;
+	std::vector<int> payload;
+
+	HeapTracked() {}
+	HeapTracked(const int& _key) : key(_key), payload(16, _key) {}
+	HeapTracked(const HeapTracked& other) : key(other.key), payload(other.payload) { copies()++; }
+	HeapTracked(HeapTracked&& other) noexcept : key(other.key), payload(std::move(other.payload)) {}
+	HeapTracked& operator=(const HeapTracked& other) { key = other.key; payload = other.payload; copies()++; return *this; }
+	HeapTracked& operator=(HeapTracked&& other) noexcept { key = other.key; payload = std::move(other.payload); return *this; }
+	bool operator<(const HeapTracked& other) const { return key < other.key; }
+};
+
+struct HeapPointerLess
+{
+	bool operator()(const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) const { return *a < *b; }
+};
+
+/// <summary>
+/// Differential test of Heap and D_AryHeap with bases 2, 3, 4, 8 and 16 against sorting and std::priority_queue,
+/// for std::less and std::greater and every instruction set of vectorized D_AryHeap, and checks that push of rvalues, emplace, growth and pop_top move items instead of copying them
+/// </summary>
+/// <param name="seed">Seed of generated inputs</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_heap_differential(const uint64_t& seed = 20240601)
+{
+	TestReport report("heap differential");
+	const std::vector<size_t> sizes = { 0, 1, 2, 3, 5, 17, 100, 1000, 10000 };
+
+	for (const size_t& size : sizes)
+	{
+		for (const InputPattern& pattern : all_input_patterns)
+		{
+			std::mt19937_64 gen(seed ^ (size * 0x9E3779B97F4A7C15ull) ^ (uint64_t)pattern);
+			std::vector<int> arr(size);
+			fill_pattern(arr.data(), size, pattern, gen);
+
+			check_heap<Heap<int>, std::less<int>>(report, arr, gen, test_case_name("Heap", pattern, size, seed));
+			check_heap<Heap<int, std::greater<int>>, std::greater<int>>(report, arr, gen, test_case_name("Heap>", pattern, size, seed));
+			check_heap<D_AryHeap<int, 2>, std::less<int>>(report, arr, gen, test_case_name("D_AryHeap<2>", pattern, size, seed));
+			check_heap<D_AryHeap<int, 3>, std::less<int>>(report, arr, gen, test_case_name("D_AryHeap<3>", pattern, size, seed));
+			check_heap<D_AryHeap<int, 4, std::greater<int>>, std::greater<int>>(report, arr, gen, test_case_name("D_AryHeap<4>>", pattern, size, seed));
+
+			//vectorized best of children on every instruction set
+			for (const SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE41, SimdLevel::AVX2 })
+			{
+				simd_limit_level(level);
+				const std::string simd = " simd=" + std::to_string((int)simd_level());
+				check_heap<D_AryHeap<int, 4>, std::less<int>>(report, arr, gen, test_case_name("D_AryHeap<4>", pattern, size, seed) + simd);
+				check_heap<D_AryHeap<int, 8>, std::less<int>>(report, arr, gen, test_case_name("D_AryHeap<8>", pattern, size, seed) + simd);
+				check_heap<D_AryHeap<int, 16, std::greater<int>>, std::greater<int>>(report, arr, gen, test_case_name("D_AryHeap<16>>", pattern, size, seed) + simd);
+
+				std::vector<float> floats(arr.begin(), arr.end()), sorted_floats = floats;
+				std::sort(sorted_floats.begin(), sorted_floats.end());
+				std::vector<unsigned int> unsigneds(arr.begin(), arr.end()), sorted_unsigneds = unsigneds;
+				std::sort(sorted_unsigneds.begin(), sorted_unsigneds.end(), std::greater<unsigned int>());
+				D_AryHeap<float, d_ary_cache_arity<float>::value> float_heap(floats.data(), size);
+				D_AryHeap<unsigned int, 8, std::greater<unsigned int>> unsigned_heap(unsigneds.data(), size);
+				for (size_t x = 0; x < size; x++)
+				{
+					floats[x] = float_heap.pop_top();
+					unsigneds[x] = unsigned_heap.pop_top();
+				}
+				report.check(floats == sorted_floats, test_case_name("D_AryHeap<float, 16>", pattern, size, seed) + simd);
+				report.check(unsigneds == sorted_unsigneds, test_case_name("D_AryHeap<unsigned int, 8>>", pattern, size, seed) + simd);
+
+				//order of NaN is undefined, but heap has to keep every item and stay in its storage
+				std::vector<float> with_nan(arr.begin(), arr.end());
+				for (size_t x = 0; x < size; x += 1 + gen() % 7)
+					with_nan[x] = std::numeric_limits<float>::quiet_NaN();
+				D_AryHeap<float, 8> nan_heap(with_nan.data(), size);
+				D_AryHeap<float, 16, std::greater<float>> nan_pushed;
+				for (const float& item : with_nan)
+					nan_pushed.push(item);
+				std::vector<float> popped, popped_pushed;
+				while (!nan_heap.empty())
+					popped.push_back(nan_heap.pop_top());
+				while (!nan_pushed.empty())
+					popped_pushed.push_back(nan_pushed.pop_top());
+				auto same_items = [&](std::vector<float> items) {
+					auto nan_last = [](const float& a, const float& b) { return std::isnan(a) ? false : std::isnan(b) ? true : a < b; };
+					std::vector<float> expected_items = with_nan;
+					std::sort(items.begin(), items.end(), nan_last);
+					std::sort(expected_items.begin(), expected_items.end(), nan_last);
+					for (size_t x = 0; x < items.size(); x++)
+						if (!(items[x] == expected_items[x] || (std::isnan(items[x]) && std::isnan(expected_items[x]))))
+							return false;
+					return items.size() == expected_items.size();
+				};
+				report.check(same_items(popped) && same_items(popped_pushed), test_case_name("D_AryHeap<float> with NaN", pattern, size, seed) + simd);
+			}
+			simd_limit_level(simd_detect_level());
+		}
+	}
+
+	//items are moved through growth, push and pop_top
+	std::mt19937_64 gen(seed);
+	HeapTracked::copies() = 0;
+	Heap<HeapTracked> heap;
+	D_AryHeap<HeapTracked, 4> d_ary_heap;
+	for (int x = 0; x < 1000; x++)
+	{
+		const int key = (int)(gen() % 1000);
+		heap.push(HeapTracked(key));
+		d_ary_heap.emplace(key);
+	}
+	bool ordered = true;
+	int previous = -1;
+	for (int x = 0; x < 1000; x++)
+	{
+		const HeapTracked top = heap.pop_top();
+		ordered &= previous <= top.key && top.payload.size() == 16 && d_ary_heap.pop_top().key == top.key;
+		previous = top.key;
+	}
+	report.check(ordered, "tracked items pop in order");
+	report.check(HeapTracked::copies() == 0, "tracked items are moved, copies=" + std::to_string(HeapTracked::copies()));
+
+	//move-only items
+	Heap<std::unique_ptr<int>, HeapPointerLess> pointers;
+	for (int x = 10; x > 0; x--)
+		pointers.emplace(new int(x));
+	bool pointers_ordered = true;
+	for (int x = 1; x <= 10; x++)
+		pointers_ordered &= *pointers.pop_top() == x;
+	report.check(pointers_ordered && pointers.empty(), "move-only items pop in order");
+
+	//capacity
+	Heap<int> reserved;
+	reserved.reserve(100);
+	report.check(reserved.get_capacity() >= 100, "reserve");
+	for (int x = 0; x < 10; x++)
+		reserved.push(x);
+	reserved.shrink_to_fit();
+	report.check(reserved.get_capacity() == 10 && reserved.top() == 0, "shrink_to_fit");
+	bool threw = false;
+	try { Heap<int>().pop_top(); }
+	catch (const std::out_of_range&) { threw = true; }
+	report.check(threw && Heap<int>().remove_top() == 0, "empty heap");
+
+	return report.summary();
+}
+
+/// <summary>
+/// Checks IndexedHeap against std::set of (key, handle) pairs on random pushes, pops, decreases, increases, changes and erases
+/// Handles of equal keys can pop in any order, so popped keys are compared and popped handle has to hold that key
+/// </summary>
+template<class HeapType, class Comparator>
+void check_indexed_heap(TestReport& report, const size_t& handle_count, const size_t& operations, std::mt19937_64& gen, const std::string& name)
+{
+	auto order = [](const std::pair<int, size_t>& a, const std::pair<int, size_t>& b) {
+		return Comparator()(a.first, b.first) || (!Comparator()(b.first, a.first) && a.second < b.second);
+	};
+	std::set<std::pair<int, size_t>, decltype(order)> expected(order);
+	std::vector<int> keys(handle_count);
+	std::vector<bool> present(handle_count, false);
+	HeapType heap;
+	std::uniform_int_distribution<int> dist(0, 1000);
+	bool same = true;
+	bool threw = true;
+
+	for (size_t x = 0; x < operations && same; x++)
+	{
+		const size_t handle = gen() % handle_count;
+		const int key = dist(gen);
+		switch (gen() % 6)
+		{
+		case 0: //push or change
+		case 1:
+			if (present[handle])
+				expected.erase(std::make_pair(keys[handle], handle));
+			same &= heap.push_or_change(handle, key) != present[handle];
+			keys[handle] = key;
+			present[handle] = true;
+			expected.insert(std::make_pair(key, handle));
+			break;
+		case 2: //pop
+			if (expected.empty())
+			{
+				try { heap.pop_top(); threw = false; }
+				catch (const std::out_of_range&) {}
+				break;
+			}
+			{
+				const std::pair<size_t, int> top = heap.pop_top();
+				same &= top.second == expected.begin()->first && present[top.first] && keys[top.first] == top.second;
+				expected.erase(std::make_pair(top.second, top.first));
+				present[top.first] = false;
+			}
+			break;
+		case 3: //decrease or increase in the right direction, the wrong one throws
+			if (!present[handle])
+			{
+				try { heap.decrease_key(handle, key); threw = false; }
+				catch (const std::out_of_range&) {}
+				break;
+			}
+			{
+				const bool towards_top = !Comparator()(keys[handle], key);
+				try
+				{
+					if (gen() % 2)
+						towards_top ? heap.decrease_key(handle, key) : heap.increase_key(handle, key);
+					else
+					{
+						towards_top ? heap.increase_key(handle, key) : heap.decrease_key(handle, key);
+						if (key != keys[handle])
+						{
+							threw = false;
+							break;
+						}
+					}
+				}
+				catch (const std::invalid_argument&)
+				{
+					break;
+				}
+				expected.erase(std::make_pair(keys[handle], handle));
+				keys[handle] = key;
+				expected.insert(std::make_pair(key, handle));
+			}
+			break;
+		case 4: //erase
+			same &= heap.erase(handle) == present[handle];
+			if (present[handle])
+				expected.erase(std::make_pair(keys[handle], handle));
+			present[handle] = false;
+			break;
+		default: //lookups
+			same &= heap.contains(handle) == present[handle] && (!present[handle] || heap.key(handle) == keys[handle]);
+			same &= heap.get_size() == expected.size() && (expected.empty() || heap.top() == expected.begin()->first);
+			break;
+		}
+	}
+	report.check(same, name + " matches std::set");
+	report.check(threw, name + " throws on absent handles, empty heap and keys moving the wrong way");
+
+	std::vector<int> popped, remaining;
+	while (!heap.empty())
+		popped.push_back(heap.pop_top().second);
+	for (const auto& item : expected)
+		remaining.push_back(item.first);
+	report.check(popped == remaining, name + " pops remaining items in order");
+}
+
+/// <summary>
+/// Differential test of IndexedHeap with bases 2, 4 and 3 (max-heap) against std::set, on few handles (many changes of the same items)
+/// and on many handles
+/// </summary>
+/// <param name="seed">Seed of generated operations</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_indexed_heap_differential(const uint64_t& seed = 20240601)
+{
+	TestReport report("indexed heap differential");
+	for (const size_t handle_count : { 1, 2, 10, 100, 5000 })
+	{
+		std::mt19937_64 gen(seed ^ handle_count);
+		const std::string name = "handles=" + std::to_string(handle_count) + " seed=" + std::to_string(seed);
+		check_indexed_heap<IndexedHeap<int>, std::less<int>>(report, handle_count, 50000, gen, "IndexedHeap<2> " + name);
+		check_indexed_heap<IndexedHeap<int, 4>, std::less<int>>(report, handle_count, 50000, gen, "IndexedHeap<4> " + name);
+		check_indexed_heap<IndexedHeap<int, 3, std::greater<int>>, std::greater<int>>(report, handle_count, 50000, gen, "IndexedHeap<3>> " + name);
+	}
+	return report.summary();
+}
+
+/// <summary>
+/// Test of MultiQueue for 1, 2, 4 and 8 threads: items pushed and popped concurrently by all threads are popped exactly once,
+/// and popped order of single thread is close to sorted (average rank error is small compared to number of items)
+/// </summary>
+/// <param name="seed">Seed of generated items</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_multi_queue(const uint64_t& seed = 20240601)
+{
+	TestReport report("multi queue");
+	const size_t per_thread = 20000;
+
+	for (const unsigned int thread_count : { 1u, 2u, 4u, 8u })
+	{
+		const std::string name = " threads=" + std::to_string(thread_count);
+		MultiQueue<int> queue(thread_count);
+		std::vector<std::vector<int>> popped(thread_count);
+		std::vector<std::thread> threads;
+		for (unsigned int t = 0; t < thread_count; t++)
+			threads.emplace_back([&, t]() {
+				std::mt19937_64 gen(seed + t);
+				int item = 0;
+				for (size_t x = 0; x < per_thread; x++)
+				{
+					queue.push((int)(t * per_thread + x));
+					if (gen() % 2 && queue.try_pop(item))
+						popped[t].push_back(item);
+				}
+			});
+		for (auto& thread : threads)
+			thread.join();
+
+		std::vector<int> all;
+		for (const auto& items : popped)
+			all.insert(all.end(), items.begin(), items.end());
+		report.check(queue.get_size() == thread_count * per_thread - all.size(), "size after concurrent pushes and pops" + name);
+		int item = 0;
+		while (queue.try_pop(item))
+			all.push_back(item);
+		report.check(queue.empty() && !queue.try_pop(item), "empty queue" + name);
+		std::sort(all.begin(), all.end());
+		bool exactly_once = all.size() == thread_count * per_thread;
+		for (size_t x = 0; exactly_once && x < all.size(); x++)
+			exactly_once = all[x] == (int)x;
+		report.check(exactly_once, "every item is popped exactly once" + name);
+
+		//relaxed order: rank of popped item among remaining items
+		std::mt19937_64 gen(seed);
+		std::vector<int> items(per_thread);
+		for (size_t x = 0; x < per_thread; x++)
+			items[x] = (int)x;
+		std::shuffle(items.begin(), items.end(), gen);
+		MultiQueue<int> relaxed(thread_count);
+		for (const int& key : items)
+			relaxed.push(key);
+		std::set<int> remaining(items.begin(), items.end());
+		double rank_sum = 0;
+		while (relaxed.try_pop(item))
+		{
+			rank_sum += (double)std::distance(remaining.begin(), remaining.find(item));
+			remaining.erase(item);
+		}
+		const double average_rank = rank_sum / per_thread;
+		report.check(remaining.empty(), "relaxed queue pops every item" + name);
+		report.check(average_rank < 4.0 * relaxed.get_shard_count(), "average rank error " + std::to_string(average_rank) + " is O(shards)" + name);
+	}
+
+	return report.summary();
+}
+
+/// <summary>
+/// Checks mergeable heap against std::multiset: items of arr are pushed into shard_count heaps, random pairs of heaps are melded
+/// until one is left, then hold model pops the top and pushes item that is not before it (so keys of RadixHeap stay monotone)
+/// and at last all items are popped. Heap has to pop items in order of Comparator
+/// </summary>
+template<class HeapType, class Comparator>
+void check_mergeable_heap(TestReport& report, const std::vector<unsigned int>& arr, const size_t& shard_count, std::mt19937_64& gen, const std::string& name)
+{
+	std::multiset<unsigned int, Comparator> expected(arr.begin(), arr.end());
+	std::vector<HeapType> shards(shard_count);
+	for (const unsigned int& item : arr)
+		shards[gen() % shard_count].push(item);
+
+	bool sizes = true;
+	while (shards.size() > 1)
+	{
+		const size_t a = gen() % shards.size();
+		const size_t b = (a + 1 + gen() % (shards.size() - 1)) % shards.size();
+		const size_t size = shards[a].get_size() + shards[b].get_size();
+		shards[a].meld(shards[b]);
+		sizes &= shards[a].get_size() == size && shards[b].empty();
+		std::swap(shards[b], shards.back());
+		shards.pop_back();
+	}
+	report.check(sizes, name + " sizes after meld");
+	HeapType& heap = shards[0];
+	report.check(heap.get_size() == arr.size(), name + " size of melded heap");
+
+	bool same = true;
+	for (size_t x = 0; x < arr.size() && same; x++)
+	{
+		const unsigned int top = heap.pop_top();
+		same &= top == *expected.begin();
+		expected.erase(expected.begin());
+		const unsigned int step = (unsigned int)(gen() % 1000);
+		const unsigned int item = Comparator()(top, top + step) ? top + step : top - std::min(top, step);
+		heap.push(item);
+		expected.insert(item);
+	}
+	while (!heap.empty() && same)
+	{
+		same &= heap.top() == *expected.begin() && heap.pop_top() == *expected.begin();
+		expected.erase(expected.begin());
+	}
+	report.check(same && heap.empty() && expected.empty(), name + " hold model and pops after meld");
+}
+
+/// <summary>
+/// Checks decrease_key of PairingHeap against std::set of (key, id) pairs: items are pushed into two heaps, popped,
+/// decreased by handles and the second heap is melded into the first, handles of melded items have to stay valid
+/// </summary>
+inline void check_pairing_heap_handles(TestReport& report, const size_t& operations, std::mt19937_64& gen, const std::string& name)
+{
+	typedef std::pair<int, size_t> Item;
+	PairingHeap<Item> heaps[2];
+	std::set<Item> expected[2];
+	std::vector<PairingHeap<Item>::Handle> handles;
+	std::vector<int> owner; //heap of item with given id, -1 after pop
+	std::uniform_int_distribution<int> dist(0, 100000);
+	bool same = true;
+
+	for (size_t x = 0; x < operations && same; x++)
+	{
+		const int side = (int)(gen() % 2);
+		switch (gen() % 8)
+		{
+		case 0: //push
+		case 1:
+		case 2:
+		{
+			const Item item(dist(gen), handles.size());
+			handles.push_back(heaps[side].push(item));
+			owner.push_back(side);
+			expected[side].insert(item);
+			same &= handles.back().get() == item;
+			break;
+		}
+		case 3: //pop
+		case 4:
+			if (!expected[side].empty())
+			{
+				const Item top = heaps[side].pop_top();
+				same &= top == *expected[side].begin();
+				expected[side].erase(expected[side].begin());
+				owner[top.second] = -1;
+			}
+			break;
+		case 5: //decrease
+		case 6:
+			if (!handles.empty())
+			{
+				const size_t id = gen() % handles.size();
+				if (owner[id] < 0)
+					break;
+				const Item old_item = handles[id].get();
+				const Item item(old_item.first - dist(gen) % 1000, id);
+				heaps[owner[id]].decrease_key(handles[id], item);
+				expected[owner[id]].erase(old_item);
+				expected[owner[id]].insert(item);
+			}
+			break;
+		case 7: //meld second heap into first
+			heaps[0].meld(heaps[1]);
+			expected[0].insert(expected[1].begin(), expected[1].end());
+			expected[1].clear();
+			for (int& side_of_item : owner)
+				side_of_item = side_of_item == 1 ? 0 : side_of_item;
+			break;
+		}
+		same &= heaps[0].get_size() == expected[0].size() && heaps[1].get_size() == expected[1].size();
+	}
+	report.check(same, name + " random pushes, pops, decreases and melds");
+
+	bool threw = false;
+	for (size_t id = 0; id < handles.size() && !threw; id++)
+		if (owner[id] >= 0)
+		{
+			try { heaps[owner[id]].decrease_key(handles[id], Item(handles[id].get().first + 1, id)); }
+			catch (const std::invalid_argument&) { threw = true; }
+		}
+	report.check(threw || expected[0].size() + expected[1].size() == 0, name + " increase by decrease_key throws std::invalid_argument");
+
+	for (int side = 0; side < 2; side++)
+	{
+		while (!heaps[side].empty() && same)
+		{
+			same &= heaps[side].pop_top() == *expected[side].begin();
+			expected[side].erase(expected[side].begin());
+		}
+		heaps[side].clear();
+	}
+	report.check(same && expected[0].empty() && expected[1].empty(), name + " pops after random operations");
+}
+
+/// <summary>
+/// Differential test of mergeable heaps: PairingHeap (both orders) and RadixHeap are melded from shards of every input pattern
+/// and checked against std::multiset, handles of PairingHeap are checked on random operations, and RadixHeap has to
+/// reject keys smaller than the last popped key
+/// </summary>
+/// <param name="seed">Seed of generated inputs</param>
+/// <returns>true if every check has passed</returns>
+inline bool test_mergeable_heaps(const uint64_t& seed = 20240601)
+{
+	TestReport report("mergeable heaps");
+	for (const size_t size : { 0, 1, 2, 3, 17, 1000, 10000 })
+	{
+		for (const InputPattern& pattern : all_input_patterns)
+		{
+			std::mt19937_64 gen(seed ^ (size * 0x9E3779B97F4A7C15ull) ^ (uint64_t)pattern);
+			std::vector<unsigned int> arr(size);
+			fill_pattern(arr.data(), size, pattern, gen);
+
+			for (const size_t shard_count : { 1, 2, 16 })
+			{
+				const std::string shards = " shards=" + std::to_string(shard_count);
+				check_mergeable_heap<PairingHeap<unsigned int>, std::less<unsigned int>>(report, arr, shard_count, gen, test_case_name("PairingHeap" + shards, pattern, size, seed));
+				check_mergeable_heap<PairingHeap<unsigned int, std::greater<unsigned int>>, std::greater<unsigned int>>(report, arr, shard_count, gen, test_case_name("PairingHeap>" + shards, pattern, size, seed));
+				check_mergeable_heap<RadixHeap<unsigned int>, std::less<unsigned int>>(report, arr, shard_count, gen, test_case_name("RadixHeap" + shards, pattern, size, seed));
+			}
+		}
+	}
+
+	for (const size_t operations : { 10, 1000, 100000 })
+	{
+		std::mt19937_64 gen(seed ^ operations);
+		check_pairing_heap_handles(report, operations, gen, "PairingHeap handles operations=" + std::to_string(operations) + " seed=" + std::to_string(seed));
+	}
+
+	RadixHeap<std::pair<uint64_t, uint32_t>, RadixHeapFirst> radix, other;
+	radix.push(std::make_pair((uint64_t)10, 0u));
+	radix.push(std::make_pair((uint64_t)20, 1u));
+	report.check(radix.pop_top().second == 0 && radix.get_last_key() == 10, "RadixHeap pops pair with the smallest key");
+	bool threw = false;
+	try { radix.push(std::make_pair((uint64_t)9, 2u)); }
+	catch (const std::invalid_argument&) { threw = true; }
+	report.check(threw && radix.get_size() == 1, "RadixHeap rejects key smaller than the last popped key");
+	other.push(std::make_pair((uint64_t)5, 3u));
+	threw = false;
+	try { radix.meld(other); }
+	catch (const std::invalid_argument&) { threw = true; }
+	report.check(threw && radix.get_size() == 1 && other.get_size() == 1, "RadixHeap rejects meld of smaller keys");
+	radix.pop_top();
+	threw = false;
+	try { radix.pop_top(); }
+	catch (const std::out_of_range&) { threw = true; }
+	report.check(threw, "pop of empty RadixHeap throws std::out_of_range");
+
+	return report.summary();
+}
@@ -1,72 +1,266 @@
 #pragma once
 #include <functional>
+#include <stdexcept>
+#include <utility>
+#include <type_traits>
+#include "Utility/simd.h"
+#include "Data Structures/heap_storage.h"
 
 //diarrhea heap
 
+//size of cache line, storage of d-ary heap starts at its beginning
+const size_t d_ary_heap_cache_line = 64;
+
+/// <summary>
+/// Number of children per parent of d-ary heap whose children fill one cache line: 16 for ints and floats,
+/// 8 for 64 bit numbers, 4 for 16 byte items, 2 for items of 32 bytes and more
+/// </summary>
+template<class T>
+struct d_ary_cache_arity
+{
+	static const int value = sizeof(T) >= d_ary_heap_cache_line / 2 ? 2 : (int)(d_ary_heap_cache_line / sizeof(T)) > 16 ? 16 : (int)(d_ary_heap_cache_line / sizeof(T));
+};
+
+//vector operations for the best of children, best is min for std::less and max for std::greater,
+//reduce returns vector with the best lane in every lane, equal returns bit mask of lanes of a equal to lanes of b
+#if SIMD_X86
+template<bool greatest>
+struct DArySseInt32
+{
+	typedef int Item;
+	typedef __m128i V;
+	enum { lanes = 4 };
+	SIMD_TARGET_SSE41 static V load(const int* p) { return _mm_loadu_si128((const __m128i*)p); }
+	SIMD_TARGET_SSE41 static V best(const V& a, const V& b) { return greatest ? _mm_max_epi32(a, b) : _mm_min_epi32(a, b); }
+	SIMD_TARGET_SSE41 static V reduce(V v)
+	{
+		v = best(v, _mm_shuffle_epi32(v, 0x4E));
+		return best(v, _mm_shuffle_epi32(v, 0xB1));
+	}
+	SIMD_TARGET_SSE41 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+};
+
+template<bool greatest>
+struct DArySseUInt32
+{
+	typedef unsigned int Item;
+	typedef __m128i V;
+	enum { lanes = 4 };
+	SIMD_TARGET_SSE41 static V load(const unsigned int* p) { return _mm_loadu_si128((const __m128i*)p); }
+	SIMD_TARGET_SSE41 static V best(const V& a, const V& b) { return greatest ? _mm_max_epu32(a, b) : _mm_min_epu32(a, b); }
+	SIMD_TARGET_SSE41 static V reduce(V v)
+	{
+		v = best(v, _mm_shuffle_epi32(v, 0x4E));
+		return best(v, _mm_shuffle_epi32(v, 0xB1));
+	}
+	SIMD_TARGET_SSE41 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+};
+
+template<bool greatest>
+struct DArySseFloat
+{
+	typedef float Item;
+	typedef __m128 V;
+	enum { lanes = 4 };
+	SIMD_TARGET_SSE41 static V load(const float* p) { return _mm_loadu_ps(p); }
+	SIMD_TARGET_SSE41 static V best(const V& a, const V& b) { return greatest ? _mm_max_ps(a, b) : _mm_min_ps(a, b); }
+	SIMD_TARGET_SSE41 static V reduce(V v)
+	{
+		v = best(v, _mm_shuffle_ps(v, v, 0x4E));
+		return best(v, _mm_shuffle_ps(v, v, 0xB1));
+	}
+	SIMD_TARGET_SSE41 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+};
+
+template<bool greatest>
+struct DAryAvx2Int32
+{
+	typedef int Item;
+	typedef __m256i V;
+	enum { lanes = 8 };
+	SIMD_TARGET_AVX2 static V load(const int* p) { return _mm256_loadu_si256((const __m256i*)p); }
+	SIMD_TARGET_AVX2 static V best(const V& a, const V& b) { return greatest ? _mm256_max_epi32(a, b) : _mm256_min_epi32(a, b); }
+	SIMD_TARGET_AVX2 static V reduce(V v)
+	{
+		v = best(v, _mm256_permute2x128_si256(v, v, 1));
+		v = best(v, _mm256_shuffle_epi32(v, 0x4E));
+		return best(v, _mm256_shuffle_epi32(v, 0xB1));
+	}
+	SIMD_TARGET_AVX2 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+};
+
+template<bool greatest>
+struct DAryAvx2UInt32
+{
+	typedef unsigned int Item;
+	typedef __m256i V;
+	enum { lanes = 8 };
+	SIMD_TARGET_AVX2 static V load(const unsigned int* p) { return _mm256_loadu_si256((const __m256i*)p); }
+	SIMD_TARGET_AVX2 static V best(const V& a, const V& b) { return greatest ? _mm256_max_epu32(a, b) : _mm256_min_epu32(a, b); }
+	SIMD_TARGET_AVX2 static V reduce(V v)
+	{
+		v = best(v, _mm256_permute2x128_si256(v, v, 1));
+		v = best(v, _mm256_shuffle_epi32(v, 0x4E));
+		return best(v, _mm256_shuffle_epi32(v, 0xB1));
+	}
+	SIMD_TARGET_AVX2 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+};
+
+template<bool greatest>
+struct DAryAvx2Float
+{
+	typedef float Item;
+	typedef __m256 V;
+	enum { lanes = 8 };
+	SIMD_TARGET_AVX2 static V load(const float* p) { return _mm256_loadu_ps(p); }
+	SIMD_TARGET_AVX2 static V best(const V& a, const V& b) { return greatest ? _mm256_max_ps(a, b) : _mm256_min_ps(a, b); }
+	SIMD_TARGET_AVX2 static V reduce(V v)
+	{
+		v = best(v, _mm256_permute2f128_ps(v, v, 1));
+		v = best(v, _mm256_permute_ps(v, 0x4E));
+		return best(v, _mm256_permute_ps(v, 0xB1));
+	}
+	SIMD_TARGET_AVX2 static unsigned int equal(const V& a, const V& b) { return (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+};
+#endif
+
+//items and comparators with vectorized best of children: 32 bit integers and floats ordered by std::less or std::greater
+template<class T, class Comparator>
+struct DAryHeapOps
+{
+	static const bool vectorized = false;
+};
+
+#if SIMD_X86
+template<class Sse, class Avx2>
+struct DAryHeapVectorOps
+{
+	static const bool vectorized = true;
+	typedef Sse SseOps;
+	typedef Avx2 Avx2Ops;
+};
+
+template<> struct DAryHeapOps<int, std::less<int>> : DAryHeapVectorOps<DArySseInt32<false>, DAryAvx2Int32<false>> {};
+template<> struct DAryHeapOps<int, std::greater<int>> : DAryHeapVectorOps<DArySseInt32<true>, DAryAvx2Int32<true>> {};
+template<> struct DAryHeapOps<unsigned int, std::less<unsigned int>> : DAryHeapVectorOps<DArySseUInt32<false>, DAryAvx2UInt32<false>> {};
+template<> struct DAryHeapOps<unsigned int, std::greater<unsigned int>> : DAryHeapVectorOps<DArySseUInt32<true>, DAryAvx2UInt32<true>> {};
+template<> struct DAryHeapOps<float, std::less<float>> : DAryHeapVectorOps<DArySseFloat<false>, DAryAvx2Float<false>> {};
+template<> struct DAryHeapOps<float, std::greater<float>> : DAryHeapVectorOps<DArySseFloat<true>, DAryAvx2Float<true>> {};
+
+//index of the best of base items of group, the first of equal ones, 64 if no item equals the best (NaN)
+//gcc and clang want the instruction set on the kernel itself, so the body is written once and stamped per target
+#define D_ARY_BEST_KERNEL(name, target) \
+template<class Ops, int base> \
+target size_t name(const typename Ops::Item* group) \
+{ \
+	typename Ops::V best = Ops::load(group); \
+	for (int x = Ops::lanes; x < base; x += Ops::lanes) \
+		best = Ops::best(best, Ops::load(group + x)); \
+	best = Ops::reduce(best); \
+	unsigned int mask = 0; \
+	for (int x = 0; x < base; x += Ops::lanes) \
+		mask |= Ops::equal(Ops::load(group + x), best) << x; \
+	return bit_trailing_zeros(mask); \
+}
+
+D_ARY_BEST_KERNEL(d_ary_best_sse, SIMD_TARGET_SSE41)
+D_ARY_BEST_KERNEL(d_ary_best_avx2, SIMD_TARGET_AVX2)
+#undef D_ARY_BEST_KERNEL
+#endif
+
 /// <summary>
 /// D-AryHeap implementation
 /// D-AryHeap is a heap, in which each parent has n children, i call it base
+/// Base is known at compile time, so index math is shifts for powers of 2 and loops over children are unrolled
+/// Storage starts at cache line and children of node k are items [k * base, k * base + base), so when base * sizeof(T) is 64
+/// (see d_ary_cache_arity) every group of children is one cache line and sift down loads one line per level
+/// Best of full groups of 4, 8 or 16 children of ints, unsigned ints and floats with std::less or std::greater is found by SSE4.1 or AVX2
+/// Items are moved, not copied, when heap grows and when they are pushed as rvalues, emplaced or taken by pop_top
 /// </summary>
 /// <typeparam name="base">Number of children per parent</typeparam>
 template<class T,int base=2, class Comparator = std::less<T>>
 class D_AryHeap
 {
+	static_assert(base >= 2, "D-ary heap needs at least 2 children per parent");
 private:
-	T* arr=nullptr;
-	size_t size = 0;
-	size_t capacity = 0;
+	HeapStorage<T, (alignof(T) > d_ary_heap_cache_line ? alignof(T) : d_ary_heap_cache_line)> storage;
+	typedef DAryHeapOps<T, Comparator> Ops;
 
 
 	/// <summary>
 	/// Gets parent of given node in base n d-ary heap
 	/// </summary>
-	/// <param name="base">Base of the heap</param>
 	/// <returns>Parent of given node</returns>
-	static size_t parent(const size_t& node, const int& base) { return node/base; }
+	static constexpr size_t parent(const size_t& node) { return node / base; }
 	/// <summary>
 	/// Gets nth child of given node in base n d-ary heap
 	/// </summary>
 	/// <param name="nth">Number of child node</param>
-	/// <param name="base">Base of the heap</param>
 	/// <returns>nth child of parent</returns>
-	static size_t child(const size_t& node, const size_t& nth, const int& base) { return  (node*base) + nth; }
+	static constexpr size_t child(const size_t& node, const size_t& nth) { return node * base + nth; }
 
-	T* get_array_copy(); //helper function to create a copy of array in heap
-	void copy_array(T* arr, const size_t& size);//copies arr into heap arr, assumes that arr is already heap
-	void delete_array();//deletes array
+	//index of the best item of full group of children starting at first
+	static size_t best_of_group(const T* arr, const size_t& first, Comparator comp, std::false_type)
+	{
+		size_t best = first;
+		for (int x = 1; x < base; x++)
+			best = comp(arr[first + x], arr[best]) ? first + x : best;
+		return best;
+	}
 
-	void build_heap(T* arr, const size_t& size, Comparator comp = Comparator()); //build heap from array
-	bool IsOk() { return size >= 0 && arr != nullptr && base>=2; }//helper function that returns false if heap is not usable
-	static bool IsOk(T* arr,const size_t& arr_size, const int& base) { return arr_size > 0 && base >= 2 && arr!=nullptr; }//helper function for checking argument of static functions
-	void resize();
+	static size_t best_of_group(const T* arr, const size_t& first, Comparator comp, std::true_type)
+	{
+#if SIMD_X86
+		//kernels are instantiated only for bases that are whole vectors
+		const SimdLevel level = simd_level();
+		size_t best = base;
+		if (base % 8 == 0 && level >= SimdLevel::AVX2)
+			best = d_ary_best_avx2<typename Ops::Avx2Ops, base % 8 == 0 ? base : 8>(arr + first);
+		else if (base % 4 == 0 && level >= SimdLevel::SSE41)
+			best = d_ary_best_sse<typename Ops::SseOps, base % 4 == 0 ? base : 4>(arr + first);
+		//NaN child can make the reduced best NaN, which equals no lane, then the scalar loop picks the child
+		if (best < (size_t)base)
+			return first + best;
+#endif
+		return best_of_group(arr, first, comp, std::false_type());
+	}
+
+	void build_heap(const T* arr, const size_t& size, Comparator comp = Comparator()); //build heap from array
+	void sift_up(size_t node, Comparator comp = Comparator()); //moves item at node up until its parent is not after it
+	static bool IsOk(const T* arr,const size_t& arr_size) { return arr_size > 0 && arr!=nullptr; }//helper function for checking argument of static functions
 public:
 	/// <summary>
 	/// Converts given array into base n d-ary heap
 	/// </summary>
-	/// <param name="base">Base of output heap</param>
-	static void array_heapify(T* arr, const size_t& size, const int& base, Comparator comp = Comparator());
+	static void array_heapify(T* arr, const size_t& size, Comparator comp = Comparator());
 	/// <summary>
 	/// Heapifies given array on given node to base n d-ary heap
 	/// </summary>
-	/// <param name="base">Base of heap</param>
-	static void heapify(T* arr, const size_t& arr_size, const size_t& node, const int& base, Comparator comp = Comparator());
+	static void heapify(T* arr, const size_t& arr_size, const size_t& node, Comparator comp = Comparator());
 
 	/// <summary>
 	/// Returns min/max child (comparator defined) of given array
 	/// Array must be proper base n d-ary heap
 	/// </summary>
-	/// <param name="base">Base of the heap</param>
 	/// <returns>Index of min/max child, if node has no children, returns node</returns>
-	static size_t get_min_child(T* arr, const size_t& arr_size, const size_t& node, const int& base, Comparator comp = Comparator());
+	static size_t get_min_child(const T* arr, const size_t& arr_size, const size_t& node, Comparator comp = Comparator());
 
 	D_AryHeap(){}
-	D_AryHeap(const size_t& _capacity) : capacity(_capacity) {}
-	D_AryHeap(T* arr, const size_t& arr_size) { build_heap(arr, arr_size); }
-	D_AryHeap(const D_AryHeap& other);
-	~D_AryHeap() { delete_array(); }
+	D_AryHeap(const size_t& _capacity) { storage.reserve(_capacity); }
+	D_AryHeap(const T* arr, const size_t& arr_size) { build_heap(arr, arr_size); }
 
-	size_t get_size() { return size; }
-	size_t get_capacity() { return capacity; }
+	size_t get_size() { return storage.size(); }
+	size_t get_capacity() { return storage.capacity(); }
+	bool empty() { return storage.empty(); }
+
+	/// <summary>
+	/// Makes room for at least capacity items, so pushes up to capacity do not reallocate
+	/// </summary>
+	void reserve(const size_t& capacity) { storage.reserve(capacity); }
+	/// <summary>
+	/// Frees memory that is not used by items of heap
+	/// </summary>
+	void shrink_to_fit() { storage.shrink_to_fit(); }
 
 	/// <summary>
 	/// pops the last element
@@ -80,6 +274,10 @@ public:
 	/// Gets the top element and deletes it, returns default value if top does not exist
 	/// </summary>
 	T remove_top();
+	/// <summary>
+	/// Moves the top element out of heap and deletes it, throws std::out_of_range if heap is empty
+	/// </summary>
+	T pop_top(Comparator comp = Comparator());
 
 	/// <summary>
 	/// Removes given element from heap, if not found nothing happens
@@ -104,7 +302,20 @@ public:
 	/// <summary>
 	/// Inserts value into heap
 	/// </summary>
-	void insert(const T& val, Comparator comp = Comparator());
+	void insert(const T& val, Comparator comp = Comparator()) { push(val, comp); }
+	/// <summary>
+	/// Inserts copy of value into heap
+	/// </summary>
+	void push(const T& val, Comparator comp = Comparator());
+	/// <summary>
+	/// Moves value into heap
+	/// </summary>
+	void push(T&& val, Comparator comp = Comparator());
+	/// <summary>
+	/// Constructs value from arguments in place in heap
+	/// </summary>
+	template<class... Args>
+	void emplace(Args&&... args);
 
 	/// <summary>
 	/// Inserts array of values into heap
@@ -115,96 +326,89 @@ public:
 };
 
 template<class T, int base, class Comparator>
-inline size_t D_AryHeap<T, base, Comparator>::get_min_child(T* arr, const size_t& arr_size, const size_t& node, const int& base, Comparator comp)
+inline size_t D_AryHeap<T, base, Comparator>::get_min_child(const T* arr, const size_t& arr_size, const size_t& node, Comparator comp)
 {
-	if (!IsOk(arr, arr_size, base))
+	if (!IsOk(arr, arr_size))
 		return node;
 
-	size_t min_child = child(node,0,base);
-	if (min_child >= arr_size)
+	const size_t first = child(node, 0);
+	if (first >= arr_size)
 		return node;
 
-	size_t actual_child = 0;
-
-	for (int x = 1; x < base; x++)
-	{
-		actual_child = child(node, x, base);
-		if (actual_child >= arr_size)
-			break;
+	if (first + base <= arr_size) //all children exist, loop over them is unrolled or vectorized
+		return best_of_group(arr, first, comp, std::integral_constant<bool, Ops::vectorized>());
 
+	size_t min_child = first;
+	for (size_t actual_child = first + 1; actual_child < arr_size; actual_child++)
 		if (comp(arr[actual_child], arr[min_child]))
 			min_child = actual_child;
-	}
 
 	return min_child;
 }
 
-template<class T, int base, class Comparator>
-inline D_AryHeap<T, base, Comparator>::D_AryHeap(const D_AryHeap& other)
-{
-	//array in other heap is already heapified, so we need only to make a copy
-	arr = new T[other.capacity];
-	for (size_t x = 0; x < other.size; x++)
-		arr[x] = other.arr[x];
-
-	size = other.size;
-	capacity = other.capacity;
-}
-
 template<class T, int base, class Comparator>
 inline void D_AryHeap<T, base, Comparator>::pop()
 {
-	if (!IsOk())
+	if (storage.empty())
 		return;
-	size--;
+	storage.pop_back();
 }
 
 template<class T, int base, class Comparator>
 inline T D_AryHeap<T, base, Comparator>::top()
 {
-	if(!IsOk())
+	if (storage.empty())
 		return T();
-	return arr[0];
+	return storage[0];
 }
 
 template<class T, int base, class Comparator>
 inline T D_AryHeap<T, base, Comparator>::remove_top()
 {
-	if (!IsOk())
+	if (storage.empty())
 		return T();
+	return pop_top();
+}
 
-	T top = top();
-	std::swap(arr[0], arr[size - 1]); //swap top with last element, then pop it
-	pop();
-	heapify(arr, size, 0,base);
+template<class T, int base, class Comparator>
+inline T D_AryHeap<T, base, Comparator>::pop_top(Comparator comp)
+{
+	if (storage.empty()) throw std::out_of_range("Heap is empty");
+
+	T top = std::move(storage[0]);
+	const size_t last = storage.size() - 1;
+	if (last > 0) //last element takes place of top, then it is heapified
+		storage[0] = std::move(storage[last]);
+	storage.pop_back();
+	heapify(storage.data(), storage.size(), 0, comp);
 	return top;
 }
 
 template<class T, int base, class Comparator>
 inline void D_AryHeap<T, base, Comparator>::remove(const T& val)
 {
-	if (!IsOk())
-		return;
-
-	size_t i = find(val);
+	const long long i = find(val);
 	if (i < 0) //value has not been found
 		return;
 
-	std::swap(arr[i], arr[size - 1]);
-	pop();
-	heapify(arr, size, i,base);
+	const size_t last = storage.size() - 1;
+	if ((size_t)i != last)
+		storage[i] = std::move(storage[last]);
+	storage.pop_back();
+	if ((size_t)i < storage.size()) //last element can belong below or above the place of removed one
+	{
+		heapify(storage.data(), storage.size(), i);
+		sift_up(i);
+	}
 }
 
 template<class T, int base, class Comparator>
 inline long long D_AryHeap<T, base, Comparator>::find(const T& val, Comparator comp)
 {
-	if (!IsOk())
-		return -1;
-
 	//simple linear search
-	for (long long x = 0; x < size; x++)
-		if (arr[x] == val)
-			return x;
+	for (size_t x = 0; x < storage.size(); x++)
+		if (storage[x] == val)
+			return (long long)x;
 
 	return -1;
 }
@@ -212,146 +416,102 @@ inline long long D_AryHeap<T, base, Comparator>::find(const T& val, Comparator c
 template<class T, int base, class Comparator>
 inline bool D_AryHeap<T, base, Comparator>::exists(const T& val)
 {
-	if (!IsOk())
-		return false;
-
 	return find(val) >= 0;
 }
 
 template<class T, int base, class Comparator>
 inline void D_AryHeap<T, base, Comparator>::change_value(const T& val, const T& new_val, Comparator comp)
 {
-	size_t i = Find(val);
+	const long long i = find(val);
 	if (i < 0)
 		return;
 
-	arr[i] = new_val;
-
-	while (i > 0 && !comp(arr[parent(i,base)], arr[i]))
-	{
-		std::swap(arr[i], arr[parent(i,base)]);
-		i = parent(i,base);
-	}
+	storage[i] = new_val;
+	heapify(storage.data(), storage.size(), i, comp);
+	sift_up(i, comp);
 }
 
 template<class T, int base, class Comparator>
-inline void D_AryHeap<T, base, Comparator>::insert(const T& val, Comparator comp)
+inline void D_AryHeap<T, base, Comparator>::sift_up(size_t node, Comparator comp)
 {
-	if (!IsOk())
-		return;
-
-	if (size == capacity)
-		resize();
-
-	size++;
-	size_t i = size - 1;
-	arr[i] = val;
-
-	//same as change value
-	while (i > 0 && !comp(arr[parent(i,base)], arr[i]))
+	//hole is moved up and item is moved once into its place, instead of swap on every level
+	T item = std::move(storage[node]);
+	while (node > 0 && comp(item, storage[parent(node)]))
 	{
-		std::swap(arr[i], arr[parent(i,base)]);
-		i = parent(i,base);
+		storage[node] = std::move(storage[parent(node)]);
+		node = parent(node);
 	}
+	storage[node] = std::move(item);
 }
 
 template<class T, int base, class Comparator>
-inline void D_AryHeap<T, base, Comparator>::insert_arr(const T* arr, const size_t& arr_size, Comparator comp)
-{
-	if (!IsOk())
-		return;
-
-	for (size_t x = 0; x < arr_size; x++)
-		insert(arr[x], comp);
-}
-
-template<class T, int base, class Comparator>
-inline T* D_AryHeap<T, base, Comparator>::get_array_copy()
+inline void D_AryHeap<T, base, Comparator>::push(const T& val, Comparator comp)
 {
-	T* out = new T[size];
-	for (size_t x = 0; x < size; x++)
-		out[x] = arr[x];
-	return out;
+	storage.emplace_back(val);
+	sift_up(storage.size() - 1, comp);
 }
 
 template<class T, int base, class Comparator>
-inline void D_AryHeap<T, base, Comparator>::copy_array(T* arr, const size_t& size)
+inline void D_AryHeap<T, base, Comparator>::push(T&& val, Comparator comp)
 {
-	//delete previous array if existed
-	delete_array();
-	this->arr = new T[size];
-	this->capacity = size;
-	this->size = size;
-
-	for (int x = 0; x < size; x++)
-		this->arr[x] = arr[x];
+	storage.emplace_back(std::move(val));
+	sift_up(storage.size() - 1, comp);
 }
 
 template<class T, int base, class Comparator>
-inline void D_AryHeap<T, base, Comparator>::delete_array()
+template<class... Args>
+inline void D_AryHeap<T, base, Comparator>::emplace(Args&&... args)
 {
-	if (arr == nullptr)
-		return;
-
-	delete[] arr;
-	size = 0;
-	arr = nullptr;
+	storage.emplace_back(std::forward<Args>(args)...);
+	sift_up(storage.size() - 1);
 }
 
 template<class T, int base, class Comparator>
-inline void D_AryHeap<T, base, Comparator>::build_heap(T* arr, const size_t& size, Comparator comp)
+inline void D_AryHeap<T, base, Comparator>::insert_arr(const T* arr, const size_t& arr_size, Comparator comp)
 {
-	delete_array();
-	copy_array(arr, size);
-
-	for (size_t x = size/base; x > 0; x--)
-		heapify(this->arr, this->size, x,base, comp);
+	storage.reserve(storage.size() + arr_size);
+	for (size_t x = 0; x < arr_size; x++)
+		push(arr[x], comp);
 }
 
 template<class T, int base, class Comparator>
-inline void D_AryHeap<T, base, Comparator>::resize()
+inline void D_AryHeap<T, base, Comparator>::build_heap(const T* arr, const size_t& size, Comparator comp)
 {
-	capacity *= 2;
-	T* arr = get_array_copy();
-	size_t old_size = size;
-	delete_array();
-
-	this->size = old_size;
-	this->arr = new T[capacity];
-
+	storage.clear();
+	storage.reserve(size);
 	for (size_t x = 0; x < size; x++)
-		this->arr[x] = arr[x];
+		storage.emplace_back(arr[x]);
 
-	delete[] arr;
+	array_heapify(storage.data(), storage.size(), comp);
 }
 
 template<class T, int base, class Comparator>
-inline void D_AryHeap<T, base, Comparator>::array_heapify(T* arr, const size_t& size, const int& base, Comparator comp)
+inline void D_AryHeap<T, base, Comparator>::array_heapify(T* arr, const size_t& size, Comparator comp)
 {
 	//use long long, size_t is unsigned, so (size_t)0 - 1 = UINT64_MAX
 	for (long long x = size/base; x >= 0; x--)
-		heapify(arr, size, x,base, comp);
+		heapify(arr, size, x, comp);
 }
 
 template<class T, int base, class Comparator>
-inline void D_AryHeap<T, base, Comparator>::heapify(T* arr, const size_t& arr_size, const size_t& node, const int& base, Comparator comp)
+inline void D_AryHeap<T, base, Comparator>::heapify(T* arr, const size_t& arr_size, const size_t& node, Comparator comp)
 {
-	if (!IsOk(arr, arr_size, base))
+	if (!IsOk(arr, arr_size))
 		return;
 
 	size_t actual = node;
-	size_t change = node;
+	size_t change = get_min_child(arr, arr_size, actual, comp);
+	if (change == actual || !comp(arr[change], arr[actual]))
+		return;
 
-	while (true)
+	//hole is moved down and item is moved once into its place, instead of swap on every level
+	//group of children of the root holds the root itself, so item is moved out only after the first level
+	T item = std::move(arr[actual]);
+	do
 	{
-		change = get_min_child(arr, arr_size, actual, base, comp);
-
-		if (actual != change)
-		{
-			std::swap(arr[actual], arr[change]);
-			actual = change;
-		}
-		else 
-			break;
-	}
+		arr[actual] = std::move(arr[change]);
+		actual = change;
+		change = get_min_child(arr, arr_size, actual, comp);
+	} while (change != actual && comp(arr[change], item));
+	arr[actual] = std::move(item);
 }
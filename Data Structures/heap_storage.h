@@ -0,0 +1,182 @@
+#pragma once
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+/// <summary>
+/// Growable array used by heaps, items [0, size) are constructed in place in memory for capacity items
+/// Growth reallocates once and moves items into new memory (trivially copyable items are moved by realloc),
+/// items are never copied unless storage itself is copied, so heaps can hold large or move-only objects
+/// </summary>
+/// <typeparam name="Alignment">Alignment of the first item, power of 2, for example 64 to start array at cache line</typeparam>
+template<class T, size_t Alignment = alignof(T)>
+class HeapStorage
+{
+private:
+	//malloc aligns to max_align_t, larger alignment keeps address returned by malloc just before the array
+	static const bool over_aligned = Alignment > alignof(std::max_align_t);
+
+	T* arr = nullptr;
+	size_t _size = 0;
+	size_t _capacity = 0;
+
+	static T* allocate(const size_t& count)
+	{
+		if (count == 0)
+			return nullptr;
+		if (!over_aligned)
+		{
+			T* memory = (T*)std::malloc(count * sizeof(T));
+			if (memory == nullptr)
+				throw std::bad_alloc();
+			return memory;
+		}
+		char* raw = (char*)std::malloc(count * sizeof(T) + Alignment + sizeof(void*));
+		if (raw == nullptr)
+			throw std::bad_alloc();
+		char* memory = (char*)(((uintptr_t)(raw + sizeof(void*)) + Alignment - 1) & ~(uintptr_t)(Alignment - 1));
+		((void**)memory)[-1] = raw;
+		return (T*)memory;
+	}
+
+	static void deallocate(T* memory)
+	{
+		if (memory != nullptr)
+			std::free(over_aligned ? ((void**)memory)[-1] : memory);
+	}
+
+	void reallocate(const size_t& new_capacity, std::true_type)
+	{
+		if (new_capacity == 0)
+		{
+			deallocate(arr);
+			arr = nullptr;
+			return;
+		}
+		if (!over_aligned)
+		{
+			T* memory = (T*)std::realloc(arr, new_capacity * sizeof(T));
+			if (memory == nullptr)
+				throw std::bad_alloc();
+			arr = memory;
+			return;
+		}
+		T* memory = allocate(new_capacity);
+		if (_size > 0)
+			std::memcpy(memory, arr, _size * sizeof(T));
+		deallocate(arr);
+		arr = memory;
+	}
+
+	void reallocate(const size_t& new_capacity, std::false_type)
+	{
+		T* memory = allocate(new_capacity);
+
+		size_t x = 0;
+		try
+		{
+			for (; x < _size; x++)
+				new (memory + x) T(std::move_if_noexcept(arr[x]));
+		}
+		catch (...)
+		{
+			while (x > 0)
+				memory[--x].~T();
+			deallocate(memory);
+			throw;
+		}
+		for (x = 0; x < _size; x++)
+			arr[x].~T();
+		deallocate(arr);
+		arr = memory;
+	}
+
+	void reallocate(const size_t& new_capacity)
+	{
+		reallocate(new_capacity, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+		_capacity = new_capacity;
+	}
+public:
+	HeapStorage() {}
+	HeapStorage(const HeapStorage& other)
+	{
+		reserve(other._size);
+		for (; _size < other._size; _size++)
+			new (arr + _size) T(other.arr[_size]);
+	}
+	HeapStorage(HeapStorage&& other) noexcept { swap(other); }
+	HeapStorage& operator=(HeapStorage other) noexcept
+	{
+		swap(other);
+		return *this;
+	}
+	~HeapStorage()
+	{
+		clear();
+		deallocate(arr);
+	}
+
+	T* data() { return arr; }
+	const T* data() const { return arr; }
+	T& operator[](const size_t& index) { return arr[index]; }
+	const T& operator[](const size_t& index) const { return arr[index]; }
+	size_t size() const { return _size; }
+	size_t capacity() const { return _capacity; }
+	bool empty() const { return _size == 0; }
+
+	//makes room for at least new_capacity items
+	void reserve(const size_t& new_capacity)
+	{
+		if (new_capacity > _capacity)
+			reallocate(new_capacity);
+	}
+
+	//frees memory that is not used by items
+	void shrink_to_fit()
+	{
+		if (_capacity > _size)
+			reallocate(_size);
+	}
+
+	//constructs new item at the end, capacity doubles when storage is full
+	template<class... Args>
+	void emplace_back(Args&&... args)
+	{
+		if (_size == _capacity)
+		{
+			//args can refer to item of this storage, so new item is made before old memory is freed
+			T item(std::forward<Args>(args)...);
+			reallocate(std::max((size_t)4, _capacity * 2));
+			new (arr + _size) T(std::move(item));
+		}
+		else
+			new (arr + _size) T(std::forward<Args>(args)...);
+		_size++;
+	}
+
+	//destroys the last item
+	void pop_back()
+	{
+		_size--;
+		arr[_size].~T();
+	}
+
+	//destroys all items, capacity stays the same
+	void clear()
+	{
+		while (_size > 0)
+			pop_back();
+	}
+
+	void swap(HeapStorage& other) noexcept
+	{
+		std::swap(arr, other.arr);
+		std::swap(_size, other._size);
+		std::swap(_capacity, other._capacity);
+	}
+};
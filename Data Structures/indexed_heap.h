@@ -0,0 +1,248 @@
+#pragma once
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// Indexed (addressable) d-ary heap, every item has handle chosen by caller (for example vertex of graph) and heap keeps
+/// position of every handle, so key of item can be decreased, increased or item erased by handle in O(log n),
+/// where Heap::change_value and Heap::remove have to find the item first in O(n)
+/// Handles are indexes into position table, so they should be small numbers (table grows to the largest handle pushed)
+/// By default this is min-heap with binary layout, base sets number of children per parent (4 is usually the fastest)
+/// </summary>
+/// <typeparam name="base">Number of children per parent</typeparam>
+/// <typeparam name="Comparator">Comparator that will be used, change to std::greater to get max-heap</typeparam>
+template<class T, int base = 2, class Comparator = std::less<T>>
+class IndexedHeap
+{
+	static_assert(base >= 2, "Heap needs at least 2 children per parent");
+private:
+	struct Entry
+	{
+		T key;
+		size_t handle;
+	};
+
+	static const size_t absent = (size_t)-1;
+
+	std::vector<Entry> heap;
+	std::vector<size_t> positions; //position of handle in heap, absent if handle is not in heap
+	Comparator comp;
+
+	static constexpr size_t parent(const size_t& node) { return (node - 1) / base; }
+	static constexpr size_t first_child(const size_t& node) { return node * base + 1; }
+
+	//puts entry at node, so position of its handle follows it
+	void place(const size_t& node, Entry&& entry)
+	{
+		positions[entry.handle] = node;
+		heap[node] = std::move(entry);
+	}
+
+	//hole is moved up and entry is moved once into its place, returns its final position
+	size_t sift_up(size_t node)
+	{
+		Entry entry = std::move(heap[node]);
+		while (node > 0 && comp(entry.key, heap[parent(node)].key))
+		{
+			const size_t up = parent(node);
+			place(node, std::move(heap[up]));
+			node = up;
+		}
+		place(node, std::move(entry));
+		return node;
+	}
+
+	//hole is moved down to the best child while it is before entry
+	void sift_down(size_t node)
+	{
+		const size_t size = heap.size();
+		Entry entry = std::move(heap[node]);
+		while (true)
+		{
+			const size_t first = first_child(node);
+			if (first >= size)
+				break;
+			const size_t last = first + base < size ? first + base : size;
+			size_t best = first;
+			for (size_t x = first + 1; x < last; x++)
+				best = comp(heap[x].key, heap[best].key) ? x : best;
+			if (!comp(heap[best].key, entry.key))
+				break;
+			place(node, std::move(heap[best]));
+			node = best;
+		}
+		place(node, std::move(entry));
+	}
+
+	size_t position_of(const size_t& handle) const
+	{
+		if (!contains(handle)) throw std::out_of_range("Handle is not in heap");
+		return positions[handle];
+	}
+public:
+	IndexedHeap(Comparator _comp = Comparator()) : comp(_comp) {}
+	/// <param name="handle_count">Handles [0, handle_count) are expected, position table is allocated once</param>
+	IndexedHeap(const size_t& handle_count, Comparator _comp = Comparator()) : positions(handle_count, absent), comp(_comp) { heap.reserve(handle_count); }
+
+	size_t get_size() const { return heap.size(); }
+	bool empty() const { return heap.empty(); }
+
+	/// <summary>
+	/// Makes room for handles [0, handle_count) and as many items
+	/// </summary>
+	void reserve(const size_t& handle_count)
+	{
+		heap.reserve(handle_count);
+		if (positions.size() < handle_count)
+			positions.resize(handle_count, absent);
+	}
+
+	/// <summary>
+	/// Returns true if item with given handle is in heap
+	/// </summary>
+	bool contains(const size_t& handle) const { return handle < positions.size() && positions[handle] != absent; }
+
+	/// <summary>
+	/// Returns key of item with given handle, throws std::out_of_range if handle is not in heap
+	/// </summary>
+	const T& key(const size_t& handle) const { return heap[position_of(handle)].key; }
+
+	/// <summary>
+	/// Gets the top key, throws std::out_of_range if heap is empty
+	/// </summary>
+	const T& top() const
+	{
+		if (heap.empty()) throw std::out_of_range("Heap is empty");
+		return heap[0].key;
+	}
+	/// <summary>
+	/// Gets handle of the top item, throws std::out_of_range if heap is empty
+	/// </summary>
+	size_t top_handle() const
+	{
+		if (heap.empty()) throw std::out_of_range("Heap is empty");
+		return heap[0].handle;
+	}
+
+	/// <summary>
+	/// Inserts item with given handle and key, throws std::invalid_argument if handle is already in heap
+	/// </summary>
+	void push(const size_t& handle, T key)
+	{
+		if (contains(handle)) throw std::invalid_argument("Handle is already in heap");
+		if (handle >= positions.size())
+			positions.resize(handle >= positions.size() * 2 ? handle + 1 : positions.size() * 2, absent);
+
+		heap.push_back(Entry{ std::move(key), handle });
+		positions[handle] = heap.size() - 1;
+		sift_up(heap.size() - 1);
+	}
+
+	/// <summary>
+	/// Inserts item, or changes its key if handle is already in heap (relaxation of edge in Dijkstra's algorithm)
+	/// Returns true if item was inserted
+	/// </summary>
+	bool push_or_change(const size_t& handle, T key)
+	{
+		if (!contains(handle))
+		{
+			push(handle, std::move(key));
+			return true;
+		}
+		change_key(handle, std::move(key));
+		return false;
+	}
+
+	/// <summary>
+	/// Moves the top item out of heap, returns its handle and key, throws std::out_of_range if heap is empty
+	/// </summary>
+	std::pair<size_t, T> pop_top()
+	{
+		if (heap.empty()) throw std::out_of_range("Heap is empty");
+
+		std::pair<size_t, T> top(heap[0].handle, std::move(heap[0].key));
+		positions[top.first] = absent;
+		Entry last = std::move(heap.back());
+		heap.pop_back();
+		if (!heap.empty())
+		{
+			heap[0] = std::move(last);
+			sift_down(0);
+		}
+		return top;
+	}
+
+	/// <summary>
+	/// Moves item with given handle towards top, new key must not be after the current one (comparator defined)
+	/// Throws std::out_of_range if handle is not in heap, std::invalid_argument if key would move item away from top
+	/// </summary>
+	void decrease_key(const size_t& handle, T key)
+	{
+		const size_t node = position_of(handle);
+		if (comp(heap[node].key, key)) throw std::invalid_argument("Key would move item away from top");
+		heap[node].key = std::move(key);
+		sift_up(node);
+	}
+
+	/// <summary>
+	/// Moves item with given handle away from top, new key must not be before the current one (comparator defined)
+	/// Throws std::out_of_range if handle is not in heap, std::invalid_argument if key would move item towards top
+	/// </summary>
+	void increase_key(const size_t& handle, T key)
+	{
+		const size_t node = position_of(handle);
+		if (comp(key, heap[node].key)) throw std::invalid_argument("Key would move item towards top");
+		heap[node].key = std::move(key);
+		sift_down(node);
+	}
+
+	/// <summary>
+	/// Changes key of item with given handle in any direction, throws std::out_of_range if handle is not in heap
+	/// </summary>
+	void change_key(const size_t& handle, T key)
+	{
+		const size_t node = position_of(handle);
+		const bool up = comp(key, heap[node].key);
+		heap[node].key = std::move(key);
+		if (up)
+			sift_up(node);
+		else
+			sift_down(node);
+	}
+
+	/// <summary>
+	/// Removes item with given handle, returns false if handle is not in heap
+	/// </summary>
+	bool erase(const size_t& handle)
+	{
+		if (!contains(handle))
+			return false;
+
+		const size_t node = positions[handle];
+		positions[handle] = absent;
+		Entry last = std::move(heap.back());
+		heap.pop_back();
+		if (node < heap.size()) //last item takes place of erased one, it can belong below or above it
+		{
+			heap[node] = std::move(last);
+			if (sift_up(node) == node)
+				sift_down(node);
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Removes all items, position table keeps its size
+	/// </summary>
+	void clear()
+	{
+		for (const Entry& entry : heap)
+			positions[entry.handle] = absent;
+		heap.clear();
+	}
+};
+
+template<class T, int base, class Comparator>
+const size_t IndexedHeap<T, base, Comparator>::absent;
@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include "Data Structures/d-aryheap.h"
+#include "Algorithms/Random/random.h"
+
+/// <summary>
+/// Concurrent priority queue with relaxed order (MultiQueue of Rihani, Sanders and Dementiev)
+/// Items are kept in shards_per_thread * thread_count heaps, every heap has its own lock. Push goes to random heap,
+/// pop locks two random heaps and takes the better of their tops, so threads rarely wait for the same lock
+/// Popped item is not always the best item of the whole queue, but its expected rank is O(number of heaps)
+/// which is enough for schedulers, where exact order costs a single lock that every thread waits for
+/// </summary>
+/// <typeparam name="Comparator">Comparator of heaps, std::less pops small items first</typeparam>
+/// <typeparam name="HeapType">Heap of one shard, it needs push(T&amp;&amp;), pop_top(), top() and empty()</typeparam>
+template<class T, class Comparator = std::less<T>, class HeapType = D_AryHeap<T, 4, Comparator>>
+class MultiQueue
+{
+private:
+	//shards are padded, so locks of neighbouring shards are not in one cache line
+	struct Shard
+	{
+		std::atomic<bool> locked;
+		HeapType heap;
+		char padding[64];
+
+		Shard() : locked(false) {}
+
+		bool try_lock() { return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire); }
+		void lock()
+		{
+			while (!try_lock())
+				std::this_thread::yield();
+		}
+		void unlock() { locked.store(false, std::memory_order_release); }
+	};
+
+	std::unique_ptr<Shard[]> shards;
+	size_t shard_count = 0;
+	std::atomic<size_t> count;
+	Comparator comp;
+
+	size_t random_shard() const { return (size_t)(StaticRandom::GetEngine()() % shard_count); }
+public:
+	/// <param name="thread_count">Number of threads that use queue, 0 -> std::thread::hardware_concurrency()</param>
+	/// <param name="shards_per_thread">Heaps per thread, more heaps mean less waiting and more relaxed order</param>
+	MultiQueue(unsigned int thread_count = 0, const size_t& shards_per_thread = 2) : count(0)
+	{
+		if (thread_count == 0)
+			thread_count = std::max(1u, std::thread::hardware_concurrency());
+		shard_count = std::max((size_t)2, thread_count * shards_per_thread);
+		shards.reset(new Shard[shard_count]);
+	}
+
+	size_t get_shard_count() const { return shard_count; }
+
+	//number of items, exact only when no other thread changes queue
+	size_t get_size() const { return count.load(std::memory_order_relaxed); }
+	bool empty() const { return get_size() == 0; }
+
+	/// <summary>
+	/// Inserts item into random heap whose lock is free
+	/// </summary>
+	void push(T item)
+	{
+		while (true)
+		{
+			Shard& shard = shards[random_shard()];
+			if (!shard.try_lock())
+				continue;
+			shard.heap.push(std::move(item));
+			count.fetch_add(1, std::memory_order_relaxed); //before unlock, so item cannot be popped before it is counted
+			shard.unlock();
+			return;
+		}
+	}
+
+	/// <summary>
+	/// Moves the better of tops of two random heaps into out, returns false if queue is empty
+	/// When random heaps are empty, all heaps are searched before queue is reported empty
+	/// </summary>
+	bool try_pop(T& out)
+	{
+		for (size_t attempt = 0; attempt < 2 * shard_count; attempt++)
+		{
+			if (count.load(std::memory_order_relaxed) == 0)
+				break;
+			size_t first = random_shard(), second = random_shard();
+			if (first == second)
+				second = (second + 1) % shard_count;
+			Shard& a = shards[std::min(first, second)];
+			Shard& b = shards[std::max(first, second)];
+			if (!a.try_lock())
+				continue;
+			if (!b.try_lock())
+			{
+				a.unlock();
+				continue;
+			}
+
+			Shard* best = a.heap.empty() ? &b : b.heap.empty() ? &a : comp(b.heap.top(), a.heap.top()) ? &b : &a;
+			const bool found = !best->heap.empty();
+			if (found)
+			{
+				out = best->heap.pop_top();
+				count.fetch_sub(1, std::memory_order_relaxed); //under lock, as in push
+			}
+			b.unlock();
+			a.unlock();
+			if (found)
+				return true;
+		}
+
+		//few items are left or locks are busy, every heap is checked
+		for (size_t x = 0; x < shard_count; x++)
+		{
+			Shard& shard = shards[x];
+			shard.lock();
+			const bool found = !shard.heap.empty();
+			if (found)
+			{
+				out = shard.heap.pop_top();
+				count.fetch_sub(1, std::memory_order_relaxed);
+			}
+			shard.unlock();
+			if (found)
+				return true;
+		}
+		return false;
+	}
+};
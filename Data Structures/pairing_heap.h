@@ -0,0 +1,348 @@
+#pragma once
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+/// <summary>
+/// Pool of nodes of one type, nodes are allocated from blocks that double in size and freed nodes are reused,
+/// so heap does not call allocator for every item. Pools can be merged in O(blocks), then nodes of both are owned by one pool
+/// </summary>
+template<class Node>
+class NodePool
+{
+private:
+	std::vector<std::pair<Node*, size_t>> blocks;
+	std::vector<std::pair<Node*, size_t>> spare; //unused ends of blocks left by merges
+	Node* free_list = nullptr; //freed nodes, linked through their first pointer
+	Node* free_tail = nullptr;
+	Node* current = nullptr; //unused end of the block nodes are taken from
+	size_t remaining = 0;
+	std::allocator<Node> allocator;
+
+	static Node*& next_free(Node* node) { return *(Node**)node; }
+
+	void release()
+	{
+		for (auto& block : blocks)
+			allocator.deallocate(block.first, block.second);
+		blocks.clear();
+		spare.clear();
+		free_list = free_tail = current = nullptr;
+		remaining = 0;
+	}
+public:
+	NodePool() {}
+	NodePool(const NodePool&) = delete;
+	NodePool& operator=(const NodePool&) = delete;
+	NodePool(NodePool&& other) noexcept { swap(other); }
+	NodePool& operator=(NodePool&& other) noexcept
+	{
+		release();
+		swap(other);
+		return *this;
+	}
+	~NodePool() { release(); }
+
+	//returns memory for one node, node is not constructed
+	Node* allocate()
+	{
+		if (free_list != nullptr)
+		{
+			Node* node = free_list;
+			free_list = next_free(node);
+			if (free_list == nullptr)
+				free_tail = nullptr;
+			return node;
+		}
+		if (remaining == 0)
+		{
+			if (!spare.empty())
+			{
+				current = spare.back().first;
+				remaining = spare.back().second;
+				spare.pop_back();
+			}
+			else
+			{
+				remaining = blocks.empty() ? 64 : blocks.back().second * 2;
+				current = allocator.allocate(remaining);
+				blocks.push_back(std::make_pair(current, remaining));
+			}
+		}
+		remaining--;
+		return current++;
+	}
+
+	//takes back memory of destroyed node
+	void deallocate(Node* node)
+	{
+		next_free(node) = free_list;
+		if (free_list == nullptr)
+			free_tail = node;
+		free_list = node;
+	}
+
+	//takes blocks and free nodes of other pool, other pool is empty after that
+	void merge(NodePool& other)
+	{
+		if (&other == this)
+			return;
+		blocks.insert(blocks.end(), other.blocks.begin(), other.blocks.end());
+		spare.insert(spare.end(), other.spare.begin(), other.spare.end());
+		if (other.free_list != nullptr)
+		{
+			next_free(other.free_tail) = free_list;
+			if (free_list == nullptr)
+				free_tail = other.free_tail;
+			free_list = other.free_list;
+		}
+
+		//the larger unused end stays current, the smaller one is kept for later
+		if (other.remaining > remaining)
+		{
+			std::swap(current, other.current);
+			std::swap(remaining, other.remaining);
+		}
+		if (other.remaining > 0)
+			spare.push_back(std::make_pair(other.current, other.remaining));
+
+		other.blocks.clear();
+		other.spare.clear();
+		other.free_list = other.free_tail = other.current = nullptr;
+		other.remaining = 0;
+	}
+
+	void swap(NodePool& other) noexcept
+	{
+		std::swap(blocks, other.blocks);
+		std::swap(spare, other.spare);
+		std::swap(free_list, other.free_list);
+		std::swap(free_tail, other.free_tail);
+		std::swap(current, other.current);
+		std::swap(remaining, other.remaining);
+	}
+};
+
+/// <summary>
+/// Pairing heap, heap ordered tree where push and meld of two heaps are O(1) (link of two roots) and pop is O(log n) amortized
+/// Children of popped root are linked in pairs from left and then folded from right (two pass pairing)
+/// Nodes come from NodePool, meld takes nodes of the other heap together with its pool, so handles stay valid
+/// Interface is shared with RadixHeap: push, top, pop_top, meld, empty, get_size and clear
+/// By default this is min-heap, change comparator to make it max-heap
+/// </summary>
+/// <typeparam name="Comparator">Comparator that will be used, change to std::greater to get max-heap</typeparam>
+template<class T, class Comparator = std::less<T>>
+class PairingHeap
+{
+private:
+	struct Node
+	{
+		Node* sibling; //first member, pool links free nodes through it
+		Node* child;
+		Node* prev; //parent for the first child, otherwise previous sibling
+		T item;
+	};
+
+	NodePool<Node> pool;
+	Node* root = nullptr;
+	size_t size = 0;
+	Comparator comp;
+
+	//makes root of loser the first child of winner, returns winner
+	Node* link(Node* a, Node* b)
+	{
+		Node* winner = comp(b->item, a->item) ? b : a;
+		Node* loser = winner == a ? b : a;
+		loser->sibling = winner->child;
+		if (winner->child != nullptr)
+			winner->child->prev = loser;
+		loser->prev = winner;
+		winner->child = loser;
+		return winner;
+	}
+
+	//two pass pairing of list of siblings, returns new root
+	Node* combine(Node* first)
+	{
+		if (first == nullptr)
+			return nullptr;
+
+		//first pass links pairs from left, linked pairs are kept in reversed list
+		Node* reversed = nullptr;
+		while (first != nullptr)
+		{
+			Node* a = first;
+			Node* b = a->sibling;
+			if (b == nullptr)
+			{
+				a->sibling = reversed;
+				reversed = a;
+				break;
+			}
+			first = b->sibling;
+			a->sibling = b->sibling = nullptr;
+			Node* winner = link(a, b);
+			winner->sibling = reversed;
+			reversed = winner;
+		}
+
+		//second pass folds pairs from right
+		Node* result = reversed;
+		reversed = reversed->sibling;
+		result->sibling = nullptr;
+		while (reversed != nullptr)
+		{
+			Node* next = reversed->sibling;
+			reversed->sibling = nullptr;
+			result = link(result, reversed);
+			reversed = next;
+		}
+		result->prev = nullptr;
+		return result;
+	}
+
+	void destroy(Node* node)
+	{
+		node->item.~T();
+		pool.deallocate(node);
+	}
+
+	//destroys all nodes, children are walked by explicit stack of siblings, so deep trees do not overflow call stack
+	void destroy_all()
+	{
+		std::vector<Node*> stack;
+		if (root != nullptr)
+			stack.push_back(root);
+		while (!stack.empty())
+		{
+			Node* node = stack.back();
+			stack.pop_back();
+			if (node->sibling != nullptr)
+				stack.push_back(node->sibling);
+			if (node->child != nullptr)
+				stack.push_back(node->child);
+			destroy(node);
+		}
+		root = nullptr;
+		size = 0;
+	}
+public:
+	/// <summary>
+	/// Handle of pushed item, valid until the item is popped, also after meld into other heap
+	/// </summary>
+	class Handle
+	{
+		friend class PairingHeap;
+		Node* node = nullptr;
+		Handle(Node* _node) : node(_node) {}
+	public:
+		Handle() {}
+		const T& get() const { return node->item; }
+	};
+
+	PairingHeap(Comparator _comp = Comparator()) : comp(_comp) {}
+	PairingHeap(const PairingHeap&) = delete;
+	PairingHeap& operator=(const PairingHeap&) = delete;
+	PairingHeap(PairingHeap&& other) noexcept : pool(std::move(other.pool)), root(other.root), size(other.size), comp(other.comp)
+	{
+		other.root = nullptr;
+		other.size = 0;
+	}
+	PairingHeap& operator=(PairingHeap&& other) noexcept
+	{
+		destroy_all();
+		pool = std::move(other.pool);
+		std::swap(root, other.root);
+		std::swap(size, other.size);
+		comp = other.comp;
+		return *this;
+	}
+	~PairingHeap() { destroy_all(); }
+
+	size_t get_size() const { return size; }
+	bool empty() const { return size == 0; }
+
+	/// <summary>
+	/// Inserts item in O(1), returns handle that can decrease its key
+	/// </summary>
+	Handle push(T item)
+	{
+		Node* node = pool.allocate();
+		new (&node->item) T(std::move(item));
+		node->sibling = node->child = node->prev = nullptr;
+		root = root == nullptr ? node : link(root, node);
+		size++;
+		return Handle(node);
+	}
+
+	/// <summary>
+	/// Gets the top item, throws std::out_of_range if heap is empty
+	/// </summary>
+	const T& top() const
+	{
+		if (root == nullptr) throw std::out_of_range("Heap is empty");
+		return root->item;
+	}
+
+	/// <summary>
+	/// Moves the top item out of heap and deletes it, throws std::out_of_range if heap is empty
+	/// </summary>
+	T pop_top()
+	{
+		if (root == nullptr) throw std::out_of_range("Heap is empty");
+
+		Node* old_root = root;
+		T item = std::move(old_root->item);
+		root = combine(old_root->child);
+		destroy(old_root);
+		size--;
+		return item;
+	}
+
+	/// <summary>
+	/// Moves all items of other heap into this one in O(1) (and O(blocks) of pool merge), other heap is empty after that
+	/// Handles of items of other heap belong to this heap
+	/// </summary>
+	void meld(PairingHeap& other)
+	{
+		if (&other == this || other.root == nullptr)
+			return;
+		pool.merge(other.pool);
+		root = root == nullptr ? other.root : link(root, other.root);
+		size += other.size;
+		other.root = nullptr;
+		other.size = 0;
+	}
+
+	/// <summary>
+	/// Moves item of handle towards top, new item must not be after the current one (comparator defined)
+	/// Throws std::invalid_argument if item would move away from top
+	/// </summary>
+	void decrease_key(const Handle& handle, T item)
+	{
+		Node* node = handle.node;
+		if (comp(node->item, item)) throw std::invalid_argument("Key would move item away from top");
+		node->item = std::move(item);
+		if (node == root)
+			return;
+
+		//subtree of node is cut out and linked with root
+		if (node->prev->child == node)
+			node->prev->child = node->sibling;
+		else
+			node->prev->sibling = node->sibling;
+		if (node->sibling != nullptr)
+			node->sibling->prev = node->prev;
+		node->sibling = node->prev = nullptr;
+		root = link(root, node);
+		root->prev = nullptr;
+	}
+
+	/// <summary>
+	/// Removes all items, memory of nodes is kept for next pushes
+	/// </summary>
+	void clear() { destroy_all(); }
+};
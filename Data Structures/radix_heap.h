@@ -0,0 +1,163 @@
+#pragma once
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include "Utility/simd.h"
+
+//key of item that is unsigned integer itself
+struct RadixHeapKey
+{
+	template<class T>
+	uint64_t operator()(const T& item) const
+	{
+		static_assert(std::is_unsigned<T>::value, "Radix heap needs unsigned integer keys");
+		return (uint64_t)item;
+	}
+};
+
+//key of pair is its first member, as (distance, vertex) pairs of Dijkstra's algorithm
+struct RadixHeapFirst
+{
+	template<class T>
+	uint64_t operator()(const T& item) const
+	{
+		static_assert(std::is_unsigned<decltype(item.first)>::value, "Radix heap needs unsigned integer keys");
+		return (uint64_t)item.first;
+	}
+};
+
+/// <summary>
+/// Radix heap, min-heap for monotone unsigned integer keys: pushed key is never smaller than the last popped key,
+/// as distances in Dijkstra's algorithm or times in event simulation
+/// Item is kept in bucket of the highest bit where its key differs from the last popped key. When bucket 0 (equal keys)
+/// is empty, the first non-empty bucket is redistributed around its smallest key, every item moves to lower buckets only,
+/// so push is O(1) and pop is O(log C) amortized, where C is the largest key. There are no comparisons between items
+/// Interface is shared with PairingHeap: push, top, pop_top, meld, empty, get_size and clear
+/// </summary>
+/// <typeparam name="KeyOf">Returns unsigned key of item, RadixHeapFirst for pairs</typeparam>
+template<class T, class KeyOf = RadixHeapKey>
+class RadixHeap
+{
+private:
+	static const int bucket_count = 65;
+
+	std::vector<T> buckets[bucket_count];
+	uint64_t last = 0; //the last popped key, keys in heap are not smaller
+	size_t size = 0;
+	KeyOf key_of;
+
+	static int bucket_of(const uint64_t& key, const uint64_t& last) { return key == last ? 0 : 64 - bit_leading_zeros(key ^ last); }
+
+	//makes bucket 0 non-empty, heap must not be empty
+	void refill()
+	{
+		if (!buckets[0].empty())
+			return;
+
+		int index = 1;
+		while (buckets[index].empty())
+			index++;
+		std::vector<T>& bucket = buckets[index];
+		uint64_t smallest = key_of(bucket[0]);
+		for (size_t x = 1; x < bucket.size(); x++)
+			smallest = std::min(smallest, key_of(bucket[x]));
+
+		last = smallest;
+		for (T& item : bucket)
+			buckets[bucket_of(key_of(item), last)].push_back(std::move(item));
+		bucket.clear();
+	}
+public:
+	RadixHeap(KeyOf _key_of = KeyOf()) : key_of(_key_of) {}
+
+	size_t get_size() const { return size; }
+	bool empty() const { return size == 0; }
+
+	/// <summary>
+	/// Returns the last popped key, pushed keys must not be smaller
+	/// </summary>
+	uint64_t get_last_key() const { return last; }
+
+	/// <summary>
+	/// Inserts item, throws std::invalid_argument if its key is smaller than the last popped key
+	/// </summary>
+	void push(T item)
+	{
+		const uint64_t key = key_of(item);
+		if (key < last) throw std::invalid_argument("Key is smaller than the last popped key");
+		buckets[bucket_of(key, last)].push_back(std::move(item));
+		size++;
+	}
+
+	/// <summary>
+	/// Gets item with the smallest key, throws std::out_of_range if heap is empty
+	/// Items with equal keys are not ordered
+	/// </summary>
+	const T& top()
+	{
+		if (size == 0) throw std::out_of_range("Heap is empty");
+		refill();
+		return buckets[0].back();
+	}
+
+	/// <summary>
+	/// Moves item with the smallest key out of heap and deletes it, throws std::out_of_range if heap is empty
+	/// </summary>
+	T pop_top()
+	{
+		if (size == 0) throw std::out_of_range("Heap is empty");
+		refill();
+		T item = std::move(buckets[0].back());
+		buckets[0].pop_back();
+		size--;
+		return item;
+	}
+
+	/// <summary>
+	/// Moves all items of other heap into this one in O(m), other heap is empty after that
+	/// Keys of other heap must not be smaller than the last popped key of this heap, otherwise std::invalid_argument
+	/// is thrown and neither heap is changed. Empty heap takes buckets and the last popped key of other heap in O(1)
+	/// </summary>
+	void meld(RadixHeap& other)
+	{
+		if (&other == this || other.size == 0)
+			return;
+		if (size == 0)
+		{
+			for (int x = 0; x < bucket_count; x++)
+				buckets[x].swap(other.buckets[x]);
+			std::swap(last, other.last);
+			std::swap(size, other.size);
+			return;
+		}
+
+		for (const std::vector<T>& bucket : other.buckets)
+			for (const T& item : bucket)
+				if (key_of(item) < last) throw std::invalid_argument("Key is smaller than the last popped key");
+		for (std::vector<T>& bucket : other.buckets)
+		{
+			for (T& item : bucket)
+				buckets[bucket_of(key_of(item), last)].push_back(std::move(item));
+			bucket.clear();
+		}
+		size += other.size;
+		other.size = 0;
+	}
+
+	/// <summary>
+	/// Removes all items, the last popped key is reset to 0
+	/// </summary>
+	void clear()
+	{
+		for (std::vector<T>& bucket : buckets)
+			bucket.clear();
+		last = 0;
+		size = 0;
+	}
+};
+
+template<class T, class KeyOf>
+const int RadixHeap<T, KeyOf>::bucket_count;
@@ -1,4 +1,8 @@
 #pragma once
 #include "Data Structures/Heap.h"
 #include "Data Structures/d-aryheap.h"
+#include "Data Structures/indexed_heap.h"
+#include "Data Structures/multi_queue.h"
+#include "Data Structures/pairing_heap.h"
+#include "Data Structures/radix_heap.h"
 #include "Data Structures/young_tableau.h"
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+#include <chrono>
+#include <map>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+/// <summary>
+/// Simple wall clock stopwatch, starts on creation
+/// </summary>
+class Stopwatch
+{
+private:
+	std::chrono::steady_clock::time_point start;
+public:
+	Stopwatch() : start(std::chrono::steady_clock::now()) {}
+
+	void Restart() { start = std::chrono::steady_clock::now(); }
+
+	//returns time since start in seconds
+	double Elapsed()
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+};
+
+/// <summary>
+/// Measures throughput of given function in items per second
+/// Function is run repeats times and the best run is taken, since noise can only make the run slower
+/// </summary>
+/// <param name="setup">Called before every run, is not timed (for example to refill the array before sorting)</param>
+/// <param name="func">Timed function</param>
+/// <param name="items">Number of items processed by single run of func</param>
+template<class Setup, class Func>
+double measure_throughput(Setup setup, Func func, const size_t& items, const int& repeats = 5)
+{
+	double best = 0;
+	for (int x = 0; x < repeats; x++)
+	{
+		setup();
+		Stopwatch watch;
+		func();
+		double elapsed = watch.Elapsed();
+		if (elapsed <= 0) //too fast for the clock
+			elapsed = 1e-9;
+		if (items / elapsed > best)
+			best = items / elapsed;
+	}
+	return best;
+}
+
+/// <summary>
+/// Same as <see cref="measure_throughput"/> but without setup step
+/// </summary>
+template<class Func>
+double measure_throughput(Func func, const size_t& items, const int& repeats = 5)
+{
+	return measure_throughput([]() {}, func, items, repeats);
+}
+
+//prints single benchmark result line in form: name: xx.xx M items/s
+inline void print_throughput(const std::string& name, const double& throughput, const std::string& unit = "items/s", std::ostream& os = std::cout)
+{
+	os << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(12) << throughput / 1e6 << " M " << unit << "\n";
+}
+
+/// <summary>
+/// Stores throughput baselines of benchmarks in plain text file, one "name throughput" pair per line
+/// Measured throughput that is lower than baseline * (1 - threshold) is treated as a regression
+/// Benchmarks without baseline are recorded, so the first run creates the baseline file
+/// </summary>
+class PerformanceBaseline
+{
+private:
+	std::string _path;
+	double _threshold;
+	std::map<std::string, double> baselines;
+	bool _updated = false;
+public:
+	PerformanceBaseline(const std::string& path, const double& threshold = 0.25) : _path(path), _threshold(threshold) { Load(); }
+
+	//loads baselines from the file, missing file means that there are no baselines yet
+	void Load()
+	{
+		baselines.clear();
+		std::ifstream file(_path);
+		std::string name;
+		double throughput = 0;
+		while (file >> std::quoted(name) >> throughput)
+			baselines[name] = throughput;
+	}
+
+	//saves baselines to the file
+	void Save()
+	{
+		std::ofstream file(_path);
+		for (auto& baseline : baselines)
+			file << std::quoted(baseline.first) << " " << std::setprecision(17) << baseline.second << "\n";
+		_updated = false;
+	}
+
+	bool HasBaseline(const std::string& name) { return baselines.count(name) > 0; }
+	double GetBaseline(const std::string& name) { return HasBaseline(name) ? baselines[name] : 0; }
+	double GetThreshold() { return _threshold; }
+
+	//overwrites baseline, use it after intentional performance changes
+	void Record(const std::string& name, const double& throughput)
+	{
+		baselines[name] = throughput;
+		_updated = true;
+	}
+
+	/// <summary>
+	/// Compares throughput with recorded baseline, records it if there is no baseline yet
+	/// </summary>
+	/// <returns>false if throughput has regressed beyond the threshold</returns>
+	bool Check(const std::string& name, const double& throughput)
+	{
+		if (!HasBaseline(name))
+		{
+			Record(name, throughput);
+			return true;
+		}
+		return throughput >= baselines[name] * (1.0 - _threshold);
+	}
+
+	~PerformanceBaseline()
+	{
+		if (_updated)
+			Save();
+	}
+};
@@ -0,0 +1,132 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define SIMD_X86 0
+#endif
+
+//gcc and clang compile intrinsics only in functions targeting their instruction set, msvc compiles them anywhere
+#if SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#endif
+
+/// <summary>
+/// Instruction sets used by vectorized algorithms, ordered from the weakest
+/// </summary>
+enum class SimdLevel
+{
+	Scalar = 0,
+	SSE41 = 1,
+	AVX2 = 2
+};
+
+//returns the best instruction set supported by cpu and operating system
+inline SimdLevel simd_detect_level()
+{
+#if SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return SimdLevel::AVX2;
+	if (__builtin_cpu_supports("sse4.1"))
+		return SimdLevel::SSE41;
+	return SimdLevel::Scalar;
+#elif SIMD_X86 && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int max_leaf = info[0];
+	__cpuid(info, 1);
+	const bool sse41 = (info[2] & (1 << 19)) != 0;
+	const bool os_saves_avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+	bool avx2 = false;
+	if (max_leaf >= 7 && os_saves_avx)
+	{
+		__cpuidex(info, 7, 0);
+		avx2 = (info[1] & (1 << 5)) != 0;
+	}
+	return avx2 ? SimdLevel::AVX2 : sse41 ? SimdLevel::SSE41 : SimdLevel::Scalar;
+#else
+	return SimdLevel::Scalar;
+#endif
+}
+
+inline SimdLevel& simd_level_storage()
+{
+	static SimdLevel level = simd_detect_level();
+	return level;
+}
+
+//instruction set used by vectorized algorithms, detected once
+inline SimdLevel simd_level() { return simd_level_storage(); }
+
+/// <summary>
+/// Limits instruction set used by vectorized algorithms (to test or benchmark weaker paths), level is never raised above the detected one
+/// Not thread safe, call it before vectorized algorithms run
+/// </summary>
+inline void simd_limit_level(const SimdLevel& level) { simd_level_storage() = std::min(level, simd_detect_level()); }
+
+//hints cpu to load cache line with given address, does nothing on unknown compilers
+inline void simd_prefetch(const void* address)
+{
+#if defined(__GNUC__)
+	__builtin_prefetch(address);
+#elif SIMD_X86 && defined(_MSC_VER)
+	_mm_prefetch((const char*)address, _MM_HINT_T0);
+#endif
+}
+
+//number of leading zero bits of x, 64 for x = 0
+inline int bit_leading_zeros(const uint64_t& x)
+{
+	if (x == 0)
+		return 64;
+#if defined(__GNUC__)
+	return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanReverse64(&index, x);
+	return 63 - (int)index;
+#else
+	int count = 0;
+	for (uint64_t bit = uint64_t(1) << 63; (x & bit) == 0; bit >>= 1)
+		count++;
+	return count;
+#endif
+}
+
+//number of trailing zero bits of x, 64 for x = 0
+inline int bit_trailing_zeros(const uint64_t& x)
+{
+	if (x == 0)
+		return 64;
+#if defined(__GNUC__)
+	return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, x);
+	return (int)index;
+#else
+	int count = 0;
+	for (uint64_t bit = 1; (x & bit) == 0; bit <<= 1)
+		count++;
+	return count;
+#endif
+}
+
+//number of set bits of x, portable bit trick, so it needs no popcnt instruction
+inline int bit_popcount(uint64_t x)
+{
+	x = x - ((x >> 1) & 0x5555555555555555ull);
+	x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+	x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return (int)((x * 0x0101010101010101ull) >> 56);
+}
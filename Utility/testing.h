@@ -1,5 +1,12 @@
 #pragma once
 #include <iostream>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <cmath>
+#include <vector>
 
 #define ARR_SIZE(arr) sizeof(arr) / sizeof(arr[0])
 
@@ -10,4 +17,151 @@ void print_array(T* arr, const size_t& size, std::ostream& os = std::cout)
     for (int x = 0; x < size; x++)
         os << arr[x] << " ";
     os << " }\n";
-}
\ No newline at end of file
+}
+
+/// <summary>
+/// Shapes of generated test inputs, algorithms tend to break on different ones
+/// </summary>
+enum class InputPattern { Random, Sorted, Reversed, FewUnique, AllEqual, OrganPipe };
+
+static const InputPattern all_input_patterns[] = { InputPattern::Random, InputPattern::Sorted, InputPattern::Reversed,
+    InputPattern::FewUnique, InputPattern::AllEqual, InputPattern::OrganPipe };
+
+inline const char* input_pattern_name(const InputPattern& pattern)
+{
+    switch (pattern)
+    {
+    case InputPattern::Random:    return "random";
+    case InputPattern::Sorted:    return "sorted";
+    case InputPattern::Reversed:  return "reversed";
+    case InputPattern::FewUnique: return "few unique";
+    case InputPattern::AllEqual:  return "all equal";
+    case InputPattern::OrganPipe: return "organ pipe";
+    }
+    return "unknown";
+}
+
+/// <summary>
+/// Fills array with values in range [0, max_value] following given pattern
+/// Uses its own std::mt19937_64, so inputs do not depend on the generators that are being tested
+/// Same generator state always produces the same array
+/// </summary>
+template<class T>
+void fill_pattern(T* arr, const size_t& size, const InputPattern& pattern, std::mt19937_64& gen, const long long& max_value = 1000000)
+{
+    std::uniform_int_distribution<long long> dist(0, max_value);
+    switch (pattern)
+    {
+    case InputPattern::Random:
+        for (size_t x = 0; x < size; x++)
+            arr[x] = T(dist(gen));
+        break;
+    case InputPattern::Sorted:
+    case InputPattern::Reversed:
+        for (size_t x = 0; x < size; x++)
+            arr[x] = T(dist(gen));
+        std::sort(arr, arr + size);
+        if (pattern == InputPattern::Reversed)
+            std::reverse(arr, arr + size);
+        break;
+    case InputPattern::FewUnique:
+        for (size_t x = 0; x < size; x++)
+            arr[x] = T(dist(gen) % 8);
+        break;
+    case InputPattern::AllEqual:
+        std::fill(arr, arr + size, T(dist(gen)));
+        break;
+    case InputPattern::OrganPipe:
+        for (size_t x = 0; x < size; x++)
+            arr[x] = T(x < size / 2 ? x : size - x);
+        break;
+    }
+}
+
+/// <summary>
+/// Collects results of checks made by a test, prints failures as they happen
+/// </summary>
+class TestReport
+{
+private:
+    std::string _name;
+    size_t _checks = 0;
+    size_t _failures = 0;
+    std::ostream& os;
+public:
+    TestReport(const std::string& name, std::ostream& out = std::cout) : _name(name), os(out) {}
+
+    //registers check, prints message if condition has failed, returns condition
+    bool check(const bool& condition, const std::string& message)
+    {
+        _checks++;
+        if (!condition)
+        {
+            _failures++;
+            os << "[FAIL] " << _name << ": " << message << "\n";
+        }
+        return condition;
+    }
+
+    size_t GetChecks() { return _checks; }
+    size_t GetFailures() { return _failures; }
+    bool Passed() { return _failures == 0; }
+
+    //prints summary of the test, returns true if every check passed
+    bool summary()
+    {
+        os << (Passed() ? "[PASS] " : "[FAIL] ") << _name << " (" << _checks - _failures << "/" << _checks << " checks)\n";
+        return Passed();
+    }
+};
+
+/// <summary>
+/// Describes reproducible test case, print it on failure so it can be replayed
+/// </summary>
+inline std::string test_case_name(const std::string& algorithm, const InputPattern& pattern, const size_t& size, const uint64_t& seed)
+{
+    return algorithm + " [" + input_pattern_name(pattern) + ", size=" + std::to_string(size) + ", seed=" + std::to_string(seed) + "]";
+}
+
+/// <summary>
+/// Pearson's chi-square statistic of observed counts against equal expected counts (uniform distribution)
+/// </summary>
+inline double chi_square(const std::vector<size_t>& counts)
+{
+    double total = 0;
+    for (const size_t& count : counts)
+        total += (double)count;
+    const double expected = total / counts.size();
+    double statistic = 0;
+    for (const size_t& count : counts)
+        statistic += ((double)count - expected) * ((double)count - expected) / expected;
+    return statistic;
+}
+
+/// <summary>
+/// Pearson's chi-square statistic of observed counts against expected counts given by probabilities that sum to 1
+/// </summary>
+inline double chi_square(const std::vector<size_t>& counts, const std::vector<double>& probabilities)
+{
+    double total = 0;
+    for (const size_t& count : counts)
+        total += (double)count;
+    double statistic = 0;
+    for (size_t x = 0; x < counts.size(); x++)
+    {
+        const double expected = total * probabilities[x];
+        statistic += ((double)counts[x] - expected) * ((double)counts[x] - expected) / expected;
+    }
+    return statistic;
+}
+
+/// <summary>
+/// Critical value of chi-square distribution with degrees_of_freedom, exceeded with chance of about 1e-4
+/// Uses Wilson-Hilferty approximation, tests with fixed seeds stay deterministic, the small chance only guards against weak seeds
+/// </summary>
+inline double chi_square_critical(const size_t& degrees_of_freedom)
+{
+    const double k = (double)degrees_of_freedom, z = 3.719; //normal quantile of 1 - 1e-4
+    const double term = 1 - 2 / (9 * k) + z * std::sqrt(2 / (9 * k));
+    return k * term * term * term;
+}
@@ -0,0 +1,417 @@
+#pragma once
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "Utility/simd.h"
+
+//vector operations used by min_max kernels, every instruction set and type has its own struct
+#if SIMD_X86
+struct MinMaxSseInt
+{
+	typedef int T;
+	typedef __m128i V;
+	enum { lanes = 4 };
+	SIMD_TARGET_SSE41 static V load(const T* p) { return _mm_loadu_si128((const __m128i*)p); }
+	SIMD_TARGET_SSE41 static void store(T* p, const V& v) { _mm_storeu_si128((__m128i*)p, v); }
+	SIMD_TARGET_SSE41 static V set1(const T& value) { return _mm_set1_epi32(value); }
+	SIMD_TARGET_SSE41 static V min(const V& a, const V& b) { return _mm_min_epi32(a, b); }
+	SIMD_TARGET_SSE41 static V max(const V& a, const V& b) { return _mm_max_epi32(a, b); }
+};
+
+struct MinMaxSseFloat
+{
+	typedef float T;
+	typedef __m128 V;
+	enum { lanes = 4 };
+	SIMD_TARGET_SSE41 static V load(const T* p) { return _mm_loadu_ps(p); }
+	SIMD_TARGET_SSE41 static void store(T* p, const V& v) { _mm_storeu_ps(p, v); }
+	SIMD_TARGET_SSE41 static V set1(const T& value) { return _mm_set1_ps(value); }
+	SIMD_TARGET_SSE41 static V min(const V& a, const V& b) { return _mm_min_ps(a, b); }
+	SIMD_TARGET_SSE41 static V max(const V& a, const V& b) { return _mm_max_ps(a, b); }
+};
+
+struct MinMaxSseDouble
+{
+	typedef double T;
+	typedef __m128d V;
+	enum { lanes = 2 };
+	SIMD_TARGET_SSE41 static V load(const T* p) { return _mm_loadu_pd(p); }
+	SIMD_TARGET_SSE41 static void store(T* p, const V& v) { _mm_storeu_pd(p, v); }
+	SIMD_TARGET_SSE41 static V set1(const T& value) { return _mm_set1_pd(value); }
+	SIMD_TARGET_SSE41 static V min(const V& a, const V& b) { return _mm_min_pd(a, b); }
+	SIMD_TARGET_SSE41 static V max(const V& a, const V& b) { return _mm_max_pd(a, b); }
+};
+
+struct MinMaxAvx2Int
+{
+	typedef int T;
+	typedef __m256i V;
+	enum { lanes = 8 };
+	SIMD_TARGET_AVX2 static V load(const T* p) { return _mm256_loadu_si256((const __m256i*)p); }
+	SIMD_TARGET_AVX2 static void store(T* p, const V& v) { _mm256_storeu_si256((__m256i*)p, v); }
+	SIMD_TARGET_AVX2 static V set1(const T& value) { return _mm256_set1_epi32(value); }
+	SIMD_TARGET_AVX2 static V min(const V& a, const V& b) { return _mm256_min_epi32(a, b); }
+	SIMD_TARGET_AVX2 static V max(const V& a, const V& b) { return _mm256_max_epi32(a, b); }
+};
+
+struct MinMaxAvx2Float
+{
+	typedef float T;
+	typedef __m256 V;
+	enum { lanes = 8 };
+	SIMD_TARGET_AVX2 static V load(const T* p) { return _mm256_loadu_ps(p); }
+	SIMD_TARGET_AVX2 static void store(T* p, const V& v) { _mm256_storeu_ps(p, v); }
+	SIMD_TARGET_AVX2 static V set1(const T& value) { return _mm256_set1_ps(value); }
+	SIMD_TARGET_AVX2 static V min(const V& a, const V& b) { return _mm256_min_ps(a, b); }
+	SIMD_TARGET_AVX2 static V max(const V& a, const V& b) { return _mm256_max_ps(a, b); }
+};
+
+struct MinMaxAvx2Double
+{
+	typedef double T;
+	typedef __m256d V;
+	enum { lanes = 4 };
+	SIMD_TARGET_AVX2 static V load(const T* p) { return _mm256_loadu_pd(p); }
+	SIMD_TARGET_AVX2 static void store(T* p, const V& v) { _mm256_storeu_pd(p, v); }
+	SIMD_TARGET_AVX2 static V set1(const T& value) { return _mm256_set1_pd(value); }
+	SIMD_TARGET_AVX2 static V min(const V& a, const V& b) { return _mm256_min_pd(a, b); }
+	SIMD_TARGET_AVX2 static V max(const V& a, const V& b) { return _mm256_max_pd(a, b); }
+};
+#endif
+
+//types with vectorized min_max kernels, other types use scalar loop
+template<class T>
+struct MinMaxVectorOps
+{
+	static const bool vectorized = false;
+};
+
+#if SIMD_X86
+template<>
+struct MinMaxVectorOps<int>
+{
+	static const bool vectorized = true;
+	typedef MinMaxSseInt Sse;
+	typedef MinMaxAvx2Int Avx2;
+};
+
+template<>
+struct MinMaxVectorOps<float>
+{
+	static const bool vectorized = true;
+	typedef MinMaxSseFloat Sse;
+	typedef MinMaxAvx2Float Avx2;
+};
+
+template<>
+struct MinMaxVectorOps<double>
+{
+	static const bool vectorized = true;
+	typedef MinMaxSseDouble Sse;
+	typedef MinMaxAvx2Double Avx2;
+};
+
+/// <summary>
+/// Minimum and maximum of at least Ops::lanes elements, 4 independent accumulators hide latency of min and max
+/// Elements after the last full group of lanes are covered by loading the last lanes elements again, since duplicates do not change the result
+/// arr[0] must not be NaN, accumulators start from it and new elements are the first operand of min and max,
+/// which return the second operand when one of them is NaN, so NaN elements are skipped
+/// One body is stamped for every instruction set, because gcc and clang need the target on the function itself
+/// </summary>
+#define MIN_MAX_KERNEL(name, target) \
+template<class Ops, bool need_min, bool need_max> \
+target void name(const typename Ops::T* arr, const size_t& size, typename Ops::T& min, typename Ops::T& max) \
+{ \
+	typedef typename Ops::T T; \
+	typedef typename Ops::V V; \
+	const size_t lanes = Ops::lanes; \
+	V min0 = Ops::set1(arr[0]), min1 = min0, min2 = min0, min3 = min0; \
+	V max0 = min0, max1 = min0, max2 = min0, max3 = min0; \
+	size_t x = 0; \
+	for (; x + 4 * lanes <= size; x += 4 * lanes) \
+	{ \
+		const V a = Ops::load(arr + x), b = Ops::load(arr + x + lanes), c = Ops::load(arr + x + 2 * lanes), d = Ops::load(arr + x + 3 * lanes); \
+		if (need_min) { min0 = Ops::min(a, min0); min1 = Ops::min(b, min1); min2 = Ops::min(c, min2); min3 = Ops::min(d, min3); } \
+		if (need_max) { max0 = Ops::max(a, max0); max1 = Ops::max(b, max1); max2 = Ops::max(c, max2); max3 = Ops::max(d, max3); } \
+	} \
+	for (; x < size; x += lanes) \
+	{ \
+		const V a = Ops::load(arr + std::min(x, size - lanes)); \
+		if (need_min) min0 = Ops::min(a, min0); \
+		if (need_max) max0 = Ops::max(a, max0); \
+	} \
+ \
+	T lanes_min[lanes], lanes_max[lanes]; \
+	Ops::store(lanes_min, Ops::min(Ops::min(min0, min1), Ops::min(min2, min3))); \
+	Ops::store(lanes_max, Ops::max(Ops::max(max0, max1), Ops::max(max2, max3))); \
+	min = lanes_min[0]; \
+	max = lanes_max[0]; \
+	for (size_t lane = 1; lane < lanes; lane++) \
+	{ \
+		if (lanes_min[lane] < min) min = lanes_min[lane]; \
+		if (max < lanes_max[lane]) max = lanes_max[lane]; \
+	} \
+}
+
+MIN_MAX_KERNEL(min_max_sse, SIMD_TARGET_SSE41)
+MIN_MAX_KERNEL(min_max_avx2, SIMD_TARGET_AVX2)
+#undef MIN_MAX_KERNEL
+#endif
+
+//minimum and maximum of non empty array without branches on elements, fallback for types and cpus without kernels
+//arr[0] must not be NaN, comparisons with NaN are false, so NaN elements are skipped
+template<class T, bool need_min, bool need_max>
+void min_max_scalar(const T* arr, const size_t& size, T& min, T& max)
+{
+	T low = arr[0], high = arr[0];
+	for (size_t x = 1; x < size; x++)
+	{
+		if (need_min) low = arr[x] < low ? arr[x] : low;
+		if (need_max) high = high < arr[x] ? arr[x] : high;
+	}
+	min = low;
+	max = high;
+}
+
+template<class T, bool need_min, bool need_max>
+void min_max_dispatch(const T* arr, const size_t& size, T& min, T& max, std::false_type)
+{
+	min_max_scalar<T, need_min, need_max>(arr, size, min, max);
+}
+
+template<class T, bool need_min, bool need_max>
+void min_max_dispatch(const T* arr, const size_t& size, T& min, T& max, std::true_type)
+{
+#if SIMD_X86
+	typedef MinMaxVectorOps<T> Ops;
+	const SimdLevel level = simd_level();
+	if (level == SimdLevel::AVX2 && size >= (size_t)Ops::Avx2::lanes)
+		return min_max_avx2<typename Ops::Avx2, need_min, need_max>(arr, size, min, max);
+	if (level >= SimdLevel::SSE41 && size >= (size_t)Ops::Sse::lanes)
+		return min_max_sse<typename Ops::Sse, need_min, need_max>(arr, size, min, max);
+#endif
+	min_max_scalar<T, need_min, need_max>(arr, size, min, max);
+}
+
+//only floating point values can be NaN, other types do not need operator ==
+template<class T>
+bool min_max_is_nan(const T&) { return false; }
+inline bool min_max_is_nan(const float& x) { return x != x; }
+inline bool min_max_is_nan(const double& x) { return x != x; }
+inline bool min_max_is_nan(const long double& x) { return x != x; }
+
+/// <summary>
+/// Minimum and/or maximum of non empty array with the best kernel for T and cpu
+/// NaN elements are skipped, if every element is NaN, min and max are NaN
+/// </summary>
+template<class T, bool need_min, bool need_max>
+void min_max_reduce(const T* arr, const size_t& size, T& min, T& max)
+{
+	size_t first = 0;
+	while (first < size && min_max_is_nan(arr[first]))
+		first++;
+	if (first == size)
+	{
+		min = max = arr[0];
+		return;
+	}
+	min_max_dispatch<T, need_min, need_max>(arr + first, size - first, min, max, std::integral_constant<bool, MinMaxVectorOps<T>::vectorized>());
+}
+
+inline void min_max_check(const void* arr, const size_t& arr_size)
+{
+	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
+	if (arr_size == 0) throw std::invalid_argument("Array cannot be empty");
+}
+
+//index of the first minimum (or maximum) of array[begin, end) that is not NaN, end if every element is NaN
+template<class T, bool is_max>
+size_t min_max_arg_scalar(const T* arr, const size_t& begin, const size_t& end)
+{
+	size_t best = begin;
+	while (best < end && min_max_is_nan(arr[best]))
+		best++;
+	for (size_t x = best + 1; x < end; x++)
+		if (is_max ? arr[best] < arr[x] : arr[x] < arr[best])
+			best = x;
+	return best;
+}
+
+/// <summary>
+/// Index of the first minimum (or maximum) of array, array is split into blocks, block minima are found with vector kernels
+/// and only the block where the result was found first is searched again for its index
+/// NaN elements are skipped, if every element is NaN, index 0 is returned
+/// </summary>
+template<class T, bool is_max>
+size_t min_max_arg(const T* arr, const size_t& arr_size)
+{
+	const size_t block = 4096;
+	T best = arr[0];
+	size_t best_block = arr_size;
+	for (size_t begin = 0; begin < arr_size; begin += block)
+	{
+		const size_t count = std::min(block, arr_size - begin);
+		T min = arr[begin], max = arr[begin];
+		min_max_reduce<T, !is_max, is_max>(arr + begin, count, min, max);
+		const T& value = is_max ? max : min;
+		if (!min_max_is_nan(value) && (best_block == arr_size || (is_max ? best < value : value < best)))
+		{
+			best = value;
+			best_block = begin;
+		}
+	}
+	if (best_block == arr_size)
+		return 0;
+
+	const size_t end = std::min(best_block + block, arr_size);
+	for (size_t x = best_block; x < end; x++)
+		if (arr[x] == best)
+			return x;
+	const size_t x = min_max_arg_scalar<T, is_max>(arr, 0, arr_size); //kernels should never report value that is not in block
+	return x == arr_size ? 0 : x;
+}
+
+/// <summary>
+/// Returns minimal element of array, int, float and double use AVX2 or SSE4.1 (detected at runtime), other types scalar loop
+/// NaN elements are skipped (as std::fmin does), array of only NaN returns NaN
+/// </summary>
+template<class T>
+T simd_min(const T* arr, const size_t& arr_size)
+{
+	min_max_check(arr, arr_size);
+	T min = arr[0], max = arr[0];
+	min_max_reduce<T, true, false>(arr, arr_size, min, max);
+	return min;
+}
+
+/// <summary>
+/// Returns maximal element of array, int, float and double use AVX2 or SSE4.1 (detected at runtime), other types scalar loop
+/// NaN elements are skipped (as std::fmax does), array of only NaN returns NaN
+/// </summary>
+template<class T>
+T simd_max(const T* arr, const size_t& arr_size)
+{
+	min_max_check(arr, arr_size);
+	T min = arr[0], max = arr[0];
+	min_max_reduce<T, false, true>(arr, arr_size, min, max);
+	return max;
+}
+
+/// <summary>
+/// Returns minimal and maximal element of array in single pass, int, float and double use AVX2 or SSE4.1, other types scalar loop
+/// NaN elements are skipped, see simd_min
+/// </summary>
+/// <returns>Pair where first -> minimum, second -> maximum</returns>
+template<class T>
+std::pair<T, T> simd_minmax(const T* arr, const size_t& arr_size)
+{
+	min_max_check(arr, arr_size);
+	T min = arr[0], max = arr[0];
+	min_max_reduce<T, true, true>(arr, arr_size, min, max);
+	return std::make_pair(min, max);
+}
+
+//returns index of the first minimal element of array, see simd_min, array of only NaN returns 0
+template<class T>
+size_t simd_argmin(const T* arr, const size_t& arr_size)
+{
+	min_max_check(arr, arr_size);
+	return min_max_arg<T, false>(arr, arr_size);
+}
+
+//returns index of the first maximal element of array, see simd_max, array of only NaN returns 0
+template<class T>
+size_t simd_argmax(const T* arr, const size_t& arr_size)
+{
+	min_max_check(arr, arr_size);
+	return min_max_arg<T, true>(arr, arr_size);
+}
+
+/// <summary>
+/// Runs func(begin, end) on thread_count consecutive parts of array and returns results of parts in order
+/// Every thread gets at least 2^16 elements, so small arrays are processed by calling thread only
+/// </summary>
+/// <param name="thread_count">Number of threads, 0 -> std::thread::hardware_concurrency()</param>
+template<class Result, class Func>
+std::vector<Result> min_max_parallel_parts(const size_t& arr_size, unsigned int thread_count, Func func)
+{
+	const size_t min_part = size_t(1) << 16;
+	if (thread_count == 0)
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	thread_count = (unsigned int)std::max((size_t)1, std::min((size_t)thread_count, arr_size / min_part));
+
+	std::vector<Result> results(thread_count);
+	std::vector<std::thread> threads;
+	for (unsigned int t = 1; t < thread_count; t++)
+		threads.emplace_back([&, t]() { results[t] = func(arr_size * t / thread_count, arr_size * (t + 1) / thread_count); });
+	results[0] = func(0, arr_size / thread_count);
+	for (auto& thread : threads)
+		thread.join();
+	return results;
+}
+
+/// <summary>
+/// Returns minimal element of array, parts of array are reduced by simd_min in thread_count threads
+/// </summary>
+/// <param name="thread_count">Number of threads, 0 -> std::thread::hardware_concurrency()</param>
+template<class T>
+T parallel_min(const T* arr, const size_t& arr_size, const unsigned int& thread_count = 0)
+{
+	min_max_check(arr, arr_size);
+	std::vector<T> parts = min_max_parallel_parts<T>(arr_size, thread_count, [arr](size_t begin, size_t end) { return simd_min(arr + begin, end - begin); });
+	return simd_min(parts.data(), parts.size());
+}
+
+//returns maximal element of array, see parallel_min
+template<class T>
+T parallel_max(const T* arr, const size_t& arr_size, const unsigned int& thread_count = 0)
+{
+	min_max_check(arr, arr_size);
+	std::vector<T> parts = min_max_parallel_parts<T>(arr_size, thread_count, [arr](size_t begin, size_t end) { return simd_max(arr + begin, end - begin); });
+	return simd_max(parts.data(), parts.size());
+}
+
+//returns minimal and maximal element of array, see parallel_min
+template<class T>
+std::pair<T, T> parallel_minmax(const T* arr, const size_t& arr_size, const unsigned int& thread_count = 0)
+{
+	min_max_check(arr, arr_size);
+	std::vector<std::pair<T, T>> parts = min_max_parallel_parts<std::pair<T, T>>(arr_size, thread_count, [arr](size_t begin, size_t end) { return simd_minmax(arr + begin, end - begin); });
+	std::pair<T, T> result = parts[0];
+	for (auto& part : parts)
+	{
+		//part of only NaN gives NaN, it is replaced by any other part
+		if (part.first < result.first || min_max_is_nan(result.first)) result.first = part.first;
+		if (result.second < part.second || min_max_is_nan(result.second)) result.second = part.second;
+	}
+	return result;
+}
+
+//returns index of the first minimal element of array, see parallel_min
+template<class T>
+size_t parallel_argmin(const T* arr, const size_t& arr_size, const unsigned int& thread_count = 0)
+{
+	min_max_check(arr, arr_size);
+	std::vector<size_t> parts = min_max_parallel_parts<size_t>(arr_size, thread_count, [arr](size_t begin, size_t end) { return begin + simd_argmin(arr + begin, end - begin); });
+	size_t result = parts[0];
+	for (auto& index : parts)
+		if (!min_max_is_nan(arr[index]) && (arr[index] < arr[result] || min_max_is_nan(arr[result])))
+			result = index;
+	return result;
+}
+
+//returns index of the first maximal element of array, see parallel_min
+template<class T>
+size_t parallel_argmax(const T* arr, const size_t& arr_size, const unsigned int& thread_count = 0)
+{
+	min_max_check(arr, arr_size);
+	std::vector<size_t> parts = min_max_parallel_parts<size_t>(arr_size, thread_count, [arr](size_t begin, size_t end) { return begin + simd_argmax(arr + begin, end - begin); });
+	size_t result = parts[0];
+	for (auto& index : parts)
+		if (!min_max_is_nan(arr[index]) && (arr[result] < arr[index] || min_max_is_nan(arr[result])))
+			result = index;
+	return result;
+}
@@ -1,5 +1,10 @@
 #pragma once
 #include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <functional>
 #include "Algorithms/Random/random.h"
 #include "Algorithms/Sorting/quicksort.h"
 
@@ -47,7 +52,7 @@ T miniumum(T* arr, const size_t& arr_size) {
 	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
 
 	T min = arr[0];
-	for (int x = 1; x < arr_size; x++)
+	for (size_t x = 1; x < arr_size; x++)
 		if (arr[x] < min)
 			min = arr[x];
 
@@ -63,7 +68,7 @@ T maximum(T* arr, const size_t& arr_size) {
 	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
 
 	T max = arr[0];
-	for (int x = 1; x < arr_size; x++)
+	for (size_t x = 1; x < arr_size; x++)
 		if (arr[x] > max)
 			max = arr[x];
 
@@ -71,25 +76,50 @@ T maximum(T* arr, const size_t& arr_size) {
 }
 
 /// <summary>
-/// Finds minimal and maximal element (1st and nth order statistic) in the array
+/// Finds indexes of minimal and maximal element in the array with 3n/2 comparisons
+/// Elements are taken in pairs, smaller one of the pair is compared only with minimum and larger one only with maximum
+/// Same as std::minmax_element, returns the first minimal and the last maximal element
 /// </summary>
-/// <returns>Pair where first -> minimum, second -> maximum</returns>
-template<class T>
-std::pair<T, T>minmax(T* arr, const size_t& arr_size) {
+/// <param name="comp">Comparator to be used, with std::greater minimum and maximum swap</param>
+/// <returns>Pair where first -> index of minimum, second -> index of maximum</returns>
+template<class T, class Comparator = std::less<T>>
+std::pair<size_t, size_t> arg_minmax(const T* arr, const size_t& arr_size, Comparator comp = Comparator()) {
 	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
-
-	T max = arr[0];
-	T min = arr[0];
-	for (int x = 1; x < arr_size; x++) {
-		if (arr[x] > max)
-			max = arr[x];
-		if (arr[x] < min)
-			min = arr[x];
+	if (arr_size == 0) throw std::invalid_argument("Array cannot be empty");
+
+	size_t min = 0, max = 0;
+	size_t x = 1;
+	if (arr_size % 2 == 0) {
+		if (comp(arr[1], arr[0])) min = 1;
+		else max = 1;
+		x = 2;
+	}
+	for (; x + 1 < arr_size; x += 2) {
+		//order inside pair is random, so it is chosen without branch
+		const bool swap = comp(arr[x + 1], arr[x]);
+		const size_t small = x + swap, large = x + !swap;
+		if (comp(arr[small], arr[min]))
+			min = small;
+		if (!comp(arr[large], arr[max]))
+			max = large;
 	}
 
 	return std::make_pair(min, max);
 }
 
+/// <summary>
+/// Finds minimal and maximal element (1st and nth order statistic) in the array with 3n/2 comparisons
+/// </summary>
+/// <param name="comp">Comparator to be used, with std::greater minimum and maximum swap</param>
+/// <returns>Pair where first -> minimum, second -> maximum</returns>
+template<class T, class Comparator = std::less<T>>
+std::pair<T, T>minmax(T* arr, const size_t& arr_size, Comparator comp = Comparator()) {
+	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
+
+	std::pair<size_t, size_t> indexes = arg_minmax(arr, arr_size, comp);
+	return std::make_pair(arr[indexes.first], arr[indexes.second]);
+}
+
 /// <summary>
 /// Randomized select algorithm is quicksort like subroutine to find nth order statistic
 /// This version uses randomized_partition instead of normal one
@@ -111,9 +141,9 @@ T randomized_select(T* arr, const size_t& p, const size_t& r, const unsigned int
 	if (i == k)
 		return arr[q];
 	else if (i < k)
-		return randomized_select(arr, p, q - 1, i);
+		return randomized_select(arr, p, q - 1, i, comp);
 	else
-		return randomized_select(arr, q + 1, r, i - k);
+		return randomized_select(arr, q + 1, r, i - k, comp);
 
 }
 
@@ -192,6 +222,21 @@ size_t order_stats_partition_around(T* arr, const size_t& p, const size_t& r, co
 	return i;
 }
 
+/// <summary>
+/// Insertion sorts group of elements lying every stride elements, starting from first
+/// Used as select subroutine
+/// </summary>
+template<class T, class Comparator = std::less<T>>
+void order_stats_sort_group(T* arr, const size_t& first, const size_t& stride, const size_t& count, Comparator comp = Comparator()) {
+	for (size_t j = 1; j < count; j++) {
+		T key = arr[first + j * stride];
+		size_t k = j;
+		for (; k > 0 && comp(key, arr[first + (k - 1) * stride]); k--)
+			arr[first + k * stride] = arr[first + (k - 1) * stride];
+		arr[first + k * stride] = key;
+	}
+}
+
 /// <summary>
 /// Selects ith order element using median of median algorithm
 /// </summary>
@@ -216,15 +261,19 @@ T select(T* arr, size_t p, size_t r, unsigned int i, const unsigned int& median_
 	}
 	size_t g = (r - p + 1) / median_count; //number of median_count element groups
 
-	for (size_t j = p, count=0; j < p + g - 1; j++,count++) //sort each group, group medians now lie in the middle of each group
-		quicksort(arr + j + count*median_count, median_count, comp);
+	for (size_t j = p; j < p + g; j++) //sort each group <arr[j], arr[j+g], arr[j+2g]...>, group medians now lie in the middle row
+		order_stats_sort_group(arr, j, g, median_count, comp);
 
-	//median of medians will lie in the middle group
+	//median of medians will lie in the middle row
 	size_t select_lower = median_count / 2;
 	size_t select_high = select_lower + 1;
 
-	size_t x = select(arr, p + select_lower * g, p + select_high * g - 1, ceil(g / 2.0), median_count, comp); //find pivot x recursively as median of group medians
-	size_t q = order_stats_partition_around(arr, p, r, x, comp); //partition around median of group medians
+	T x = select(arr, p + select_lower * g, p + select_high * g - 1, ceil(g / 2.0), median_count, comp); //find pivot x recursively as median of group medians
+	size_t pv = p + select_lower * g;
+	while (comp(arr[pv], x) || comp(x, arr[pv])) //recursive select only permutes the middle row, so pivot is somewhere there
+		pv++;
+
+	size_t q = order_stats_partition_around(arr, p, r, pv, comp); //partition around median of group medians
 	size_t k = q - p + 1;
 
 	if (i == k)
@@ -256,3 +305,326 @@ T select_ith(T* arr, const size_t& arr_size, const unsigned int& ith, const unsi
 	return out;
 }
 
+
+/// <summary>
+/// Branchless partition of range [p, r), elements x for which comp(x, pivot) is true are moved to the front
+/// Every element is swapped unconditionally and only the index of lowside is advanced by comparison result,
+/// so there are no mispredicted branches on random data
+/// </summary>
+/// <returns>Index of first element for which comp(x, pivot) is false</returns>
+template<class T, class Comparator = std::less<T>>
+size_t order_stats_branchless_partition(T* arr, const size_t& p, const size_t& r, const T& pivot, Comparator comp = Comparator())
+{
+	size_t i = p; //highest index in the lowside
+	for (size_t j = p; j < r; j++)
+	{
+		bool low = comp(arr[j], pivot);
+		std::swap(arr[i], arr[j]);
+		i += low;
+	}
+	return i;
+}
+
+template<class T, class Comparator>
+void introselect_range(T* arr, size_t p, size_t r, const size_t& k, Comparator comp, int bad_partitions);
+
+/// <summary>
+/// Median of medians pivot of range [p:r], groups of 5 elements lying every g elements are sorted
+/// and median of group medians is selected with introselect that uses only median of medians pivots
+/// Used as introselect subroutine when partitions do not shrink the range
+/// </summary>
+/// <returns>Index of pivot, at least 3/10 of range is not greater and 3/10 is not smaller than pivot</returns>
+template<class T, class Comparator = std::less<T>>
+size_t order_stats_median_of_medians(T* arr, const size_t& p, const size_t& r, Comparator comp = Comparator())
+{
+	const size_t g = (r - p + 1) / 5; //number of groups
+	if (g == 0)
+	{
+		order_stats_sort_group(arr, p, 1, r - p + 1, comp);
+		return p + (r - p) / 2;
+	}
+
+	for (size_t j = p; j < p + g; j++) //group medians now lie in the middle row [p+2g, p+3g)
+		order_stats_sort_group(arr, j, g, 5, comp);
+
+	const size_t median = p + 2 * g + (g - 1) / 2;
+	introselect_range(arr, p + 2 * g, p + 3 * g - 1, median, comp, -1);
+	return median;
+}
+
+/// <summary>
+/// Introselect, puts kth smallest element of range [p:r] on index k, smaller elements before it and greater after it (as std::nth_element)
+/// Pivots of large ranges are chosen by Floyd-Rivest sampling: random sample is moved around k and recursively selected, so pivot lands very close to k
+/// and the next partition cuts off almost the whole range. Small ranges use median of 3 pivots
+/// Partitions use branchless kernel, ranges where pivot is minimum are partitioned again around pivot, so duplicates are removed at once
+/// When partitions stall, it switches to median of medians pivots, so worst case is O(n)
+/// </summary>
+/// <param name="k">Absolute index of element to select, p &lt;= k &lt;= r</param>
+/// <param name="bad_partitions">Number of partitions that may keep more than 3/4 of range before switching to median of medians, -1 uses only median of medians</param>
+template<class T, class Comparator>
+void introselect_range(T* arr, size_t p, size_t r, const size_t& k, Comparator comp, int bad_partitions)
+{
+	const size_t small = 24;
+	while (r - p + 1 > small)
+	{
+		const size_t n = r - p + 1;
+		size_t pv;
+		if (bad_partitions < 0)
+			pv = order_stats_median_of_medians(arr, p, r, comp);
+		else if (n > 600)
+		{
+			//Floyd-Rivest: select k within sample around k, its size is about n^(2/3)/2 and it is shifted by few standard deviations towards the middle
+			const double nn = (double)n;
+			const double i = (double)(k - p + 1);
+			const double z = std::log(nn);
+			const double s = 0.5 * std::exp(2 * z / 3);
+			const double sd = 0.5 * std::sqrt(z * s * (nn - s) / nn) * (i < nn / 2 ? -1 : 1);
+			const size_t left = std::min(k, (size_t)std::max((double)p, (double)k - i * s / nn + sd));
+			const size_t right = std::max(k, (size_t)std::min((double)r, (double)k + (nn - i) * s / nn + sd));
+			Xoshiro256StarStar& engine = StaticRandom::GetEngine();
+			for (size_t x = left; x <= right; x++) //random sample, so sorted runs around k do not bias pivot
+				std::swap(arr[x], arr[p + (size_t)random_bounded(engine, n)]);
+			introselect_range(arr, left, right, k, comp, bad_partitions);
+			pv = k;
+		}
+		else //median of 3
+		{
+			size_t m = p + (r - p) / 2;
+			if (comp(arr[m], arr[p])) std::swap(arr[m], arr[p]);
+			if (comp(arr[r], arr[m])) std::swap(arr[r], arr[m]);
+			if (comp(arr[m], arr[p])) std::swap(arr[m], arr[p]);
+			pv = m;
+		}
+
+		std::swap(arr[pv], arr[r]);
+		const T pivot = arr[r];
+		size_t q = order_stats_branchless_partition(arr, p, r, pivot, comp);
+		std::swap(arr[q], arr[r]);
+
+		if (k == q)
+			return;
+		else if (k < q)
+			r = q - 1;
+		else if (q == p) //pivot is minimum, move elements equal to it next to it
+		{
+			q = order_stats_branchless_partition(arr, p + 1, r + 1, pivot, [&comp](const T& x, const T& y) { return !comp(y, x); });
+			if (k < q)
+				return;
+			p = q;
+		}
+		else p = q + 1;
+
+		if (bad_partitions >= 0 && (r - p + 1) * 4 > n * 3)
+			bad_partitions--;
+	}
+	order_stats_sort_group(arr, p, 1, r - p + 1, comp);
+}
+
+/// <summary>
+/// Introselect, reorders array so that ith order statistic is on index i-1, smaller elements are before it and greater after it
+/// Works in place as std::nth_element, runs in O(n) time also in the worst case
+/// </summary>
+/// <param name="comp">Comparator to be used, std::less can be used to find ith smallest element, std::greater to find ith greatest element</param>
+/// <param name="i">number of order statistic i=1 -> minimum, i=arr_size -> maximum</param>
+/// <returns>ith order element</returns>
+template<class T, class Comparator = std::less<T>>
+T introselect(T* arr, const size_t& arr_size, const size_t& i, Comparator comp = Comparator()) {
+	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
+	if (i == 0 || i > arr_size) throw std::out_of_range("Order statistic has to be in range [1, arr_size]");
+
+	introselect_range(arr, 0, arr_size - 1, i - 1, comp, 4);
+	return arr[i - 1];
+}
+
+/// <summary>
+/// Returns ith order statistic using introselect, drop-in replacement of ith_order, input array is not modified
+/// </summary>
+/// <param name="comp">Comparator to be used, std::less can be used to find ith smallest element, std::greater to find ith greatest element</param>
+/// <param name="i">number of order statistic i=1 -> minimum, i=arr_size -> maximum</param>
+/// <returns>ith order element</returns>
+template<class T, class Comparator = std::less<T>>
+T ith_order_introselect(T* arr, const size_t& arr_size, const unsigned int& i, Comparator comp = Comparator()) {
+	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
+	if (i == 0 || i > arr_size) throw std::out_of_range("Order statistic has to be in range [1, arr_size]");
+
+	T* arr_cpy = new T[arr_size];
+	std::copy(arr, arr + arr_size, arr_cpy); //work on copy, otherwise array item order will get changed
+
+	T out = introselect(arr_cpy, arr_size, i, comp);
+	delete[] arr_cpy;
+	return out;
+}
+
+/// <summary>
+/// Multi-select, puts kth smallest element of range [p:r] on index k for every k in sorted list ks, every other element ends up between
+/// the nearest selected indexes. Middle index is selected first with introselect, then left and right part are recursively processed
+/// only with indexes lying in them, so it runs in O(n log(k_count)) instead of O(n k_count)
+/// </summary>
+/// <param name="ks">Sorted absolute indexes in range [p:r], duplicates are allowed</param>
+template<class T, class Comparator = std::less<T>>
+void multiselect_range(T* arr, const size_t& p, const size_t& r, const size_t* ks, const size_t& k_count, Comparator comp = Comparator())
+{
+	if (k_count == 0)
+		return;
+
+	const size_t mid = k_count / 2;
+	const size_t k = ks[mid];
+	introselect_range(arr, p, r, k, comp, 4);
+
+	const size_t left_count = std::lower_bound(ks, ks + mid, k) - ks; //indexes equal to k are already done
+	const size_t* right = std::upper_bound(ks + mid, ks + k_count, k);
+	if (left_count > 0)
+		multiselect_range(arr, p, k - 1, ks, left_count, comp);
+	if (right != ks + k_count)
+		multiselect_range(arr, k + 1, r, right, (ks + k_count) - right, comp);
+}
+
+/// <summary>
+/// Finds many order statistics at once, in place, array is reordered so that every requested order statistic i lies on index i-1
+/// Runs in O(n log(rank_count)), which is much faster than calling ith_order for every rank
+/// </summary>
+/// <param name="ranks">Sorted ranks of order statistics, rank=1 -> minimum, rank=arr_size -> maximum</param>
+/// <param name="out">Receives rank_count order statistics, out[x] is ranks[x]th order statistic</param>
+/// <param name="comp">Comparator to be used, std::less can be used to find smallest elements, std::greater to find greatest elements</param>
+template<class T, class Comparator = std::less<T>>
+void multi_select(T* arr, const size_t& arr_size, const size_t* ranks, const size_t& rank_count, T* out, Comparator comp = Comparator())
+{
+	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
+	for (size_t x = 0; x < rank_count; x++)
+	{
+		if (ranks[x] == 0 || ranks[x] > arr_size) throw std::out_of_range("Order statistic has to be in range [1, arr_size]");
+		if (x > 0 && ranks[x] < ranks[x - 1]) throw std::invalid_argument("Ranks have to be sorted");
+	}
+	if (rank_count == 0)
+		return;
+
+	std::vector<size_t> ks(rank_count);
+	for (size_t x = 0; x < rank_count; x++)
+		ks[x] = ranks[x] - 1;
+
+	multiselect_range(arr, 0, arr_size - 1, ks.data(), rank_count, comp);
+	for (size_t x = 0; x < rank_count; x++)
+		out[x] = arr[ks[x]];
+}
+
+/// <summary>
+/// Finds many quantiles at once, in place, quantile q is order statistic ceil(q * arr_size), at least 1
+/// For example quantiles = {0.5, 0.9, 0.99, 0.999} gives p50, p90, p99 and p999 in single call of multi_select
+/// </summary>
+/// <param name="quantiles">Sorted quantiles in range [0, 1]</param>
+/// <param name="out">Receives quantile_count values</param>
+template<class T, class Comparator = std::less<T>>
+void multi_quantile(T* arr, const size_t& arr_size, const double* quantiles, const size_t& quantile_count, T* out, Comparator comp = Comparator())
+{
+	std::vector<size_t> ranks(quantile_count);
+	for (size_t x = 0; x < quantile_count; x++)
+	{
+		if (quantiles[x] < 0 || quantiles[x] > 1) throw std::out_of_range("Quantile has to be in range [0, 1]");
+		double rank = quantiles[x] * arr_size;
+		double nearest = std::round(rank);
+		if (std::abs(rank - nearest) <= 1e-9 * std::max(1.0, rank)) //0.9 * 10 is 9.000000000000002, which is still 9th statistic
+			rank = nearest;
+		ranks[x] = std::min(arr_size, std::max((size_t)1, (size_t)std::ceil(rank)));
+	}
+	multi_select(arr, arr_size, ranks.data(), quantile_count, out, comp);
+}
+
+/// <summary>
+/// Returns ith order statistic using thread_count threads, input array is not modified
+/// Two pivots bracketing the ith element are chosen as order statistics of random sample of n^(2/3) elements,
+/// in single pass over their parts of array threads count elements below pivots and copy elements between pivots into their buffers,
+/// which are expected to have O(n^(2/3)) elements together, then ith element is selected from them sequentially
+/// Single pass does not copy whole array, so even with one thread it is faster than ith_order_introselect
+/// If pivots miss the ith element (rarely), it falls back to introselect on copy of whole array
+/// </summary>
+/// <param name="i">number of order statistic i=1 -> minimum, i=arr_size -> maximum</param>
+/// <param name="thread_count">Number of threads, 0 -> std::thread::hardware_concurrency()</param>
+/// <param name="comp">Comparator to be used, std::less can be used to find ith smallest element, std::greater to find ith greatest element</param>
+/// <returns>ith order element</returns>
+template<class T, class Comparator = std::less<T>>
+T parallel_ith_order(T* arr, const size_t& arr_size, const size_t& i, unsigned int thread_count = 0, Comparator comp = Comparator()) {
+	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
+	if (i == 0 || i > arr_size) throw std::out_of_range("Order statistic has to be in range [1, arr_size]");
+	if (thread_count == 0)
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+	auto sequential = [&]() {
+		std::vector<T> copy(arr, arr + arr_size);
+		return introselect(copy.data(), arr_size, i, comp);
+	};
+	const size_t min_parallel_size = size_t(1) << 15;
+	if (arr_size < min_parallel_size)
+		return sequential();
+
+	//pivots are order statistics of sample around expected position of ith element, 3 standard deviations away
+	const size_t sample_size = std::min(arr_size, std::max((size_t)1024, (size_t)std::pow((double)arr_size, 2.0 / 3)));
+	std::vector<T> sample(sample_size);
+	Xoshiro256StarStar& engine = StaticRandom::GetEngine();
+	for (auto& item : sample)
+		item = arr[random_bounded(engine, arr_size)];
+
+	const double position = (double)(i - 1) * sample_size / arr_size;
+	const double delta = 3 * std::sqrt((double)sample_size);
+	size_t ranks[2] = { (size_t)std::max(1.0, position - delta + 1), (size_t)std::min((double)sample_size, position + delta + 1) };
+	T pivots[2];
+	multi_select(sample.data(), sample_size, ranks, 2, pivots, comp);
+	const T low = pivots[0], high = pivots[1];
+	const bool low_bound = ranks[0] > 1, high_bound = ranks[1] < sample_size; //sample extremes are not bounds, array may have more extreme elements
+
+	auto run_parallel = [&](const std::function<void(unsigned int, size_t, size_t)>& func) {
+		std::vector<std::thread> threads;
+		for (unsigned int t = 1; t < thread_count; t++)
+			threads.emplace_back(func, t, arr_size * t / thread_count, arr_size * (t + 1) / thread_count);
+		func(0, 0, arr_size / thread_count);
+		for (auto& thread : threads)
+			thread.join();
+	};
+
+	//every thread counts elements below pivots and copies elements between pivots into its own buffer
+	std::vector<size_t> below(thread_count, 0);
+	std::vector<std::vector<T>> between(thread_count);
+	const size_t expected_between = (size_t)(2 * delta / sample_size * arr_size / thread_count);
+	run_parallel([&](unsigned int t, size_t begin, size_t end) {
+		const size_t block = 1024;
+		std::vector<T>& out = between[t];
+		out.resize(expected_between + block);
+		size_t below_count = 0, count = 0;
+		for (size_t block_begin = begin; block_begin < end; block_begin += block)
+		{
+			const size_t block_end = std::min(end, block_begin + block);
+			if (out.size() < count + block)
+				out.resize(std::max(out.size() * 2, count + block));
+
+			//every item is written, but count advances only for items between pivots, so there is no branch
+			T* dst = out.data();
+			for (size_t x = block_begin; x < block_end; x++)
+			{
+				const T item = arr[x];
+				const bool is_below = low_bound & comp(item, low);
+				const bool is_above = high_bound & comp(high, item);
+				below_count += is_below;
+				dst[count] = item;
+				count += !is_below & !is_above;
+			}
+		}
+		out.resize(count);
+		below[t] = below_count;
+	});
+
+	size_t below_total = 0, between_total = 0;
+	for (unsigned int t = 0; t < thread_count; t++)
+	{
+		below_total += below[t];
+		between_total += between[t].size();
+	}
+	if (i <= below_total || i > below_total + between_total) //pivots do not bracket ith element
+		return sequential();
+	if (low_bound && high_bound && !comp(low, high)) //pivots are equal, so everything between them is equal
+		return low;
+
+	std::vector<T> buffer;
+	buffer.reserve(between_total);
+	for (auto& part : between)
+		buffer.insert(buffer.end(), part.begin(), part.end());
+	return introselect(buffer.data(), between_total, i - below_total, comp);
+}
@@ -0,0 +1,263 @@
+#pragma once
+#include <stdexcept>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include "order_statistics.h"
+
+/// <summary>
+/// KLL quantile sketch (Karnin, Lang, Liberty), approximates ranks and quantiles of unbounded stream in bounded memory
+/// Items are kept in levels of compactors, item on level h stands for 2^h items of stream. When level is full it is sorted
+/// and every other item (starting randomly at first or second) is promoted to the next level. Capacities shrink by 2/3 towards lower levels,
+/// so sketch keeps about 3k items, and rank error is about 1.7/k * n with high propability (k=200 -> 0.85%)
+/// Until the first compaction sketch holds every item, so queries are answered exactly by order statistics algorithms
+/// Sketches with the same k can be merged, so every thread can fill its own sketch
+/// </summary>
+/// <typeparam name="Comparator">Comparator that defines order of items</typeparam>
+template<class T, class Comparator = std::less<T>>
+class QuantileSketch
+{
+private:
+	size_t _k = 200;
+	unsigned long long count = 0; //number of items in stream
+	size_t size = 0; //number of items kept in sketch
+	size_t max_size = 0; //sum of capacities of levels
+	bool exact = true; //true until first compaction
+	std::vector<std::vector<T>> levels;
+	T min_item, max_item;
+	Xoshiro256StarStar engine;
+	Comparator comp;
+
+	size_t capacity(const size_t& level)
+	{
+		const size_t depth = levels.size() - level - 1;
+		return (size_t)std::ceil(_k * std::pow(2.0 / 3, (double)depth)) + 1;
+	}
+
+	void grow()
+	{
+		levels.emplace_back();
+		max_size = 0;
+		for (size_t h = 0; h < levels.size(); h++)
+			max_size += capacity(h);
+	}
+
+	//compacts the lowest level that is over its capacity
+	void compress()
+	{
+		for (size_t h = 0; h < levels.size(); h++)
+		{
+			if (levels[h].size() < capacity(h))
+				continue;
+			if (h + 1 == levels.size())
+				grow();
+
+			std::vector<T>& level = levels[h];
+			std::sort(level.begin(), level.end(), comp);
+
+			//odd item stays on its level, so promoted items come in pairs
+			const size_t kept = level.size() % 2;
+			const size_t offset = engine() & 1;
+			std::vector<T>& next = levels[h + 1];
+			for (size_t x = kept + offset; x < level.size(); x += 2)
+				next.push_back(level[x]);
+			level.resize(kept);
+
+			exact = false;
+			size = 0;
+			for (auto& items : levels)
+				size += items.size();
+			return;
+		}
+	}
+
+	//items with their weights sorted by comp
+	std::vector<std::pair<T, unsigned long long>> weighted_items()
+	{
+		std::vector<std::pair<T, unsigned long long>> items;
+		items.reserve(size);
+		for (size_t h = 0; h < levels.size(); h++)
+			for (auto& item : levels[h])
+				items.emplace_back(item, 1ull << h);
+		std::sort(items.begin(), items.end(), [this](const std::pair<T, unsigned long long>& a, const std::pair<T, unsigned long long>& b) { return comp(a.first, b.first); });
+		return items;
+	}
+
+	//rank of order statistic of quantile q, same as in multi_quantile
+	unsigned long long quantile_rank(const double& q)
+	{
+		if (q < 0 || q > 1) throw std::out_of_range("Quantile has to be in range [0, 1]");
+		double rank = q * count;
+		double nearest = std::round(rank);
+		if (std::abs(rank - nearest) <= 1e-9 * std::max(1.0, rank))
+			rank = nearest;
+		return std::min(count, std::max(1ull, (unsigned long long)std::ceil(rank)));
+	}
+public:
+	/// <param name="k">Accuracy parameter, larger k uses more memory and has smaller error, at least 8</param>
+	QuantileSketch(const size_t& k = 200, Comparator comparator = Comparator()) : QuantileSketch(k, StaticRandom::GetEngine()(), comparator) {}
+	QuantileSketch(const size_t& k, const uint64_t& seed, Comparator comparator = Comparator()) : _k(std::max((size_t)8, k)), engine(seed), comp(comparator)
+	{
+		grow();
+	}
+
+	size_t GetK() { return _k; }
+	unsigned long long GetCount() { return count; }
+	bool IsExact() { return exact; }
+
+	//number of items kept in sketch, memory used by items is MemoryUsage() * sizeof(T)
+	size_t MemoryUsage() { return size; }
+
+	void Insert(const T& item)
+	{
+		if (count == 0 || comp(item, min_item)) min_item = item;
+		if (count == 0 || comp(max_item, item)) max_item = item;
+		levels[0].push_back(item);
+		count++;
+		size++;
+		while (size >= max_size)
+			compress();
+	}
+
+	//inserts count items, level 0 is filled by whole runs of items between compactions
+	void InsertRange(const T* items, const size_t& items_count)
+	{
+		size_t x = 0;
+		while (x < items_count)
+		{
+			if (count == 0)
+			{
+				min_item = max_item = items[0];
+			}
+			const size_t run = std::min(items_count - x, max_size - size);
+			for (size_t end = x + run; x < end; x++)
+			{
+				if (comp(items[x], min_item)) min_item = items[x];
+				if (comp(max_item, items[x])) max_item = items[x];
+				levels[0].push_back(items[x]);
+			}
+			count += run;
+			size += run;
+			while (size >= max_size)
+				compress();
+		}
+	}
+
+	/// <summary>
+	/// Returns estimated number of items not greater than item, exact while IsExact()
+	/// </summary>
+	unsigned long long Rank(const T& item)
+	{
+		unsigned long long rank = 0;
+		for (size_t h = 0; h < levels.size(); h++)
+			for (auto& kept : levels[h])
+				if (!comp(item, kept))
+					rank += 1ull << h;
+		return rank;
+	}
+
+	/// <summary>
+	/// Returns estimated ith order statistic of stream, i=1 -> minimum, i=GetCount() -> maximum
+	/// While sketch is exact, order statistic is selected exactly with introselect
+	/// </summary>
+	T Ith(const unsigned long long& i)
+	{
+		if (i == 0 || i > count) throw std::out_of_range("Order statistic has to be in range [1, GetCount()]");
+		if (i == 1) return min_item;
+		if (i == count) return max_item;
+		if (exact)
+		{
+			std::vector<T> copy(levels[0]);
+			return introselect(copy.data(), copy.size(), (size_t)i, comp);
+		}
+
+		auto items = weighted_items();
+		unsigned long long cumulative = 0;
+		for (auto& item : items)
+		{
+			cumulative += item.second;
+			if (cumulative >= i)
+				return item.first;
+		}
+		return max_item;
+	}
+
+	//returns estimated quantile q in range [0, 1], quantile q is order statistic ceil(q * GetCount())
+	T Quantile(const double& q) { return Ith(quantile_rank(q)); }
+
+	/// <summary>
+	/// Returns many quantiles at once, sketch is sorted only once (while exact, multi_select is used)
+	/// </summary>
+	/// <param name="quantiles">Sorted quantiles in range [0, 1]</param>
+	/// <param name="out">Receives quantile_count values</param>
+	void Quantiles(const double* quantiles, const size_t& quantile_count, T* out)
+	{
+		if (count == 0) throw std::out_of_range("Sketch is empty");
+		if (exact)
+		{
+			std::vector<T> copy(levels[0]);
+			multi_quantile(copy.data(), copy.size(), quantiles, quantile_count, out, comp);
+			return;
+		}
+
+		auto items = weighted_items();
+		unsigned long long cumulative = 0;
+		size_t next = 0;
+		for (size_t x = 0; x < quantile_count; x++)
+		{
+			unsigned long long rank = quantile_rank(quantiles[x]);
+			if (x > 0 && rank < quantile_rank(quantiles[x - 1])) throw std::invalid_argument("Quantiles have to be sorted");
+			if (rank == 1) { out[x] = min_item; continue; }
+			if (rank == count) { out[x] = max_item; continue; }
+			while (next < items.size() && cumulative + items[next].second < rank)
+				cumulative += items[next++].second;
+			out[x] = next < items.size() ? items[next].first : max_item;
+		}
+	}
+
+	/// <summary>
+	/// Merges other sketch into this one, levels are concatenated and compacted until sketch fits into its capacity
+	/// Returns false and does nothing if k differs
+	/// </summary>
+	bool Merge(const QuantileSketch& other)
+	{
+		if (other._k != _k)
+			return false;
+		if (other.count == 0)
+			return true;
+
+		if (count == 0 || comp(other.min_item, min_item)) min_item = other.min_item;
+		if (count == 0 || comp(max_item, other.max_item)) max_item = other.max_item;
+		while (levels.size() < other.levels.size())
+			grow();
+		for (size_t h = 0; h < other.levels.size(); h++)
+			levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+		count += other.count;
+		size += other.size;
+		exact = exact && other.exact;
+
+		while (size >= max_size)
+			compress();
+		return true;
+	}
+};
+
+/// <summary>
+/// Returns ith order statistic of array, exactly with ith_order_introselect if array has at most exact_size items,
+/// otherwise approximately from QuantileSketch with given k, which needs only O(k) memory instead of copy of array
+/// </summary>
+/// <param name="i">number of order statistic i=1 -> minimum, i=arr_size -> maximum</param>
+template<class T, class Comparator = std::less<T>>
+T approximate_ith_order(T* arr, const size_t& arr_size, const size_t& i, const size_t& k = 200, const size_t& exact_size = 100000, Comparator comp = Comparator())
+{
+	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
+	if (i == 0 || i > arr_size) throw std::out_of_range("Order statistic has to be in range [1, arr_size]");
+	if (arr_size <= exact_size)
+		return ith_order_introselect(arr, arr_size, (unsigned int)i, comp);
+
+	QuantileSketch<T, Comparator> sketch(k, comp);
+	sketch.InsertRange(arr, arr_size);
+	return sketch.Ith(i);
+}
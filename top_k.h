@@ -0,0 +1,126 @@
+#pragma once
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include "Data Structures/Heap.h"
+#include "order_statistics.h"
+
+/// <summary>
+/// Keeps k greatest items of stream (by comparator) in bounded heap of k items, top of heap is the smallest kept item,
+/// so new item is compared only with it and most items of long stream are rejected by single comparison
+/// Adding n items takes O(n log k) in the worst case, memory is O(k)
+/// </summary>
+/// <typeparam name="Comparator">Comparator that defines order of items, std::less keeps the greatest items, std::greater the smallest</typeparam>
+template<class T, class Comparator = std::less<T>>
+class TopK
+{
+private:
+	std::vector<T> heap; //heap ordered by comp, heap[0] is the smallest kept item
+	size_t _k = 0;
+	unsigned long long count = 0;
+	Comparator comp;
+
+	void replace_top(const T& item)
+	{
+		heap[0] = item;
+		Heap<T, Comparator>::heapify(heap.data(), heap.size(), 0, comp);
+	}
+public:
+	TopK(const size_t& k, Comparator comparator = Comparator()) : _k(k), comp(comparator) { heap.reserve(k); }
+
+	size_t GetK() { return _k; }
+	unsigned long long GetCount() { return count; }
+
+	void Add(const T& item)
+	{
+		count++;
+		if (heap.size() < _k)
+		{
+			heap.push_back(item);
+			if (heap.size() == _k)
+				Heap<T, Comparator>::array_heapify(heap.data(), heap.size(), comp);
+		}
+		else if (_k > 0 && comp(heap[0], item))
+			replace_top(item);
+	}
+
+	void AddRange(const T* items, const size_t& items_count)
+	{
+		size_t x = 0;
+		for (; x < items_count && heap.size() < _k; x++)
+			Add(items[x]);
+		if (_k == 0 || x == items_count)
+		{
+			count += items_count - x;
+			return;
+		}
+
+		//heap is full, only items greater than the smallest kept one get in
+		count += items_count - x;
+		for (; x < items_count; x++)
+			if (comp(heap[0], items[x]))
+				replace_top(items[x]);
+	}
+
+	/// <summary>
+	/// Adds items kept by other TopK, result keeps k greatest items of both streams
+	/// </summary>
+	void Merge(const TopK& other)
+	{
+		const unsigned long long other_count = other.count;
+		AddRange(other.heap.data(), other.heap.size());
+		count += other_count - other.heap.size();
+	}
+
+	/// <summary>
+	/// Returns kept items sorted from the greatest, min(k, GetCount()) items
+	/// </summary>
+	std::vector<T> GetSorted()
+	{
+		std::vector<T> out(heap);
+		Comparator less = comp;
+		std::sort(out.begin(), out.end(), [less](const T& a, const T& b) { return less(b, a); });
+		return out;
+	}
+
+	void Clear()
+	{
+		heap.clear();
+		count = 0;
+	}
+};
+
+/// <summary>
+/// Moves k greatest items of array (by comparator) to its beginning, sorted from the greatest, rest of array is in unspecified order
+/// Kth greatest item is selected with introselect, which partitions array around it, then only k items are sorted
+/// Takes O(n + k log k), with k=100 and n in millions it is about as fast as single pass over array
+/// </summary>
+/// <param name="k">Number of items, k >= arr_size sorts whole array</param>
+/// <param name="comp">Comparator that defines order of items, std::less moves the greatest items, std::greater the smallest</param>
+template<class T, class Comparator = std::less<T>>
+void top_k(T* arr, const size_t& arr_size, size_t k, Comparator comp = Comparator())
+{
+	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
+	k = std::min(k, arr_size);
+	if (k == 0)
+		return;
+
+	auto greater = [comp](const T& a, const T& b) { return comp(b, a); };
+	if (k < arr_size)
+		introselect(arr, arr_size, k, greater);
+	std::sort(arr, arr + k, greater);
+}
+
+/// <summary>
+/// Returns k greatest items of array (by comparator) sorted from the greatest, array is not modified
+/// Single pass with TopK, takes O(n log k) in the worst case and O(k) memory, for random order of items about O(n + k log k log n)
+/// </summary>
+template<class T, class Comparator = std::less<T>>
+std::vector<T> streaming_top_k(const T* arr, const size_t& arr_size, const size_t& k, Comparator comp = Comparator())
+{
+	if (arr == nullptr) throw std::invalid_argument("Array cannot be nullptr");
+	TopK<T, Comparator> top(k, comp);
+	top.AddRange(arr, arr_size);
+	return top.GetSorted();
+}